@@ -22,142 +22,339 @@
 //
 //	2013-10-05	initial version
 
+#include "programimage.h"
 #include "programmodel.h"
+#include "recreator.h"
 #include "token.h"
 
 
 // REM FUNCTIONS
 
-quint16 remEncode(ProgramModel *programUnit, Token *token)
+quint32 remEncode(ProgramModel *programUnit, Token *token)
 {
-	return programUnit->remDictionary()->add(token, Qt::CaseSensitive);
+	return programUnit->remDictionary()->add(token);
 }
 
-const QString remOperandText(const ProgramModel *programUnit, quint16 operand)
+const QString remOperandText(const ProgramModel *programUnit, quint32 operand)
 {
 	return programUnit->remDictionary()->string(operand);
 }
 
-void remRemove(ProgramModel *programUnit, quint16 operand)
+void remRemove(ProgramModel *programUnit, quint32 operand)
 {
 	programUnit->remDictionary()->remove(operand);
 }
 
+void remRecreate(Recreator &recreator, Code code)
+{
+	recreator.append(recreator.table().name(code) + recreator.operandText());
+}
 
-// CONSTANT FUNCTIONS
+// remark operator is separated from a statement before it on the line
 
-ConstNumInfo::ConstNumInfo(void)
+void remOpRecreate(Recreator &recreator, Code code)
 {
-	// default constructor needed for QVector
+	if (!recreator.output().isEmpty() && !recreator.output().endsWith(' '))
+	{
+		recreator.append(" ");
+	}
+	remRecreate(recreator, code);
 }
 
-ConstNumInfo::ConstNumInfo(Token *token)
+
+// CONSTANT FUNCTIONS
+
+quint32 ConstNumDictionary::add(Token *token)
 {
-	m_value = token->value();
-	m_valueInt = token->valueInt();
+	EntryType returnNewEntry;
+	int index = Dictionary::add(token, &returnNewEntry);
+	if (returnNewEntry != Exists_Entry)
+	{
+		int valueIndex = addValue(token->value(), token->valueInt());
+		if (returnNewEntry == New_Entry)
+		{
+			m_valueIndex.append(valueIndex);
+		}
+		else  // Reused_Entry
+		{
+			m_valueIndex[index] = valueIndex;
+		}
+	}
+	return index;
 }
 
-quint16 constNumEncode(ProgramModel *programUnit, Token *token)
+void ConstNumDictionary::remove(quint32 index)
 {
-	return programUnit->constNumDictionary()->add(token);
+	Dictionary::remove(index);
+	if (keyHandle(index) == -1)  // entry removed?
+	{
+		int valueIndex = m_valueIndex.at(index);
+		if (--m_valueUseCount[valueIndex] == 0)  // value no longer used?
+		{
+			quint64 bits;
+			memcpy(&bits, &m_value.at(valueIndex), sizeof(bits));
+			m_valueHash.remove(bits);
+			m_valueFreeStack.push(valueIndex);
+		}
+		m_valueIndex[index] = -1;
+	}
 }
 
-const QString constNumOperandText(const ProgramModel *programUnit,
-	quint16 operand)
+// function to add a value (or another use of a value already present)
+//
+//   - values are compared by their bits (so 0 and -0 are different values)
+
+int ConstNumDictionary::addValue(double value, int valueInt)
 {
-	return programUnit->constNumDictionary()->string(operand);
+	quint64 bits;
+	memcpy(&bits, &value, sizeof(bits));
+	int valueIndex = m_valueHash.value(bits, -1);
+	if (valueIndex != -1)  // value already present?
+	{
+		m_valueUseCount[valueIndex]++;
+	}
+	else if (m_valueFreeStack.isEmpty())  // no free values available?
+	{
+		valueIndex = m_value.count();
+		m_value.append(value);
+		m_valueInt.append(valueInt);
+		m_valueUseCount.append(1);
+		m_valueHash.insert(bits, valueIndex);
+	}
+	else  // use a previously freed value
+	{
+		valueIndex = m_valueFreeStack.pop();
+		m_value[valueIndex] = value;
+		m_valueInt[valueIndex] = valueInt;
+		m_valueUseCount[valueIndex] = 1;
+		m_valueHash.insert(bits, valueIndex);
+	}
+	return valueIndex;
 }
 
-void constNumRemove(ProgramModel *programUnit, quint16 operand)
+// function to return the memory of the values (and their value indexes)
+int ConstNumDictionary::infoMemory(void) const
 {
-	programUnit->constNumDictionary()->remove(operand);
+	struct Node
+	{
+		Node *next;
+		uint hash;
+		quint64 key;
+		int value;
+	};
+	return m_valueIndex.capacity() * sizeof(int)
+		+ m_value.capacity() * sizeof(double)
+		+ m_valueInt.capacity() * sizeof(qint32)
+		+ m_valueUseCount.capacity() * sizeof(int)
+		+ m_valueFreeStack.capacity() * sizeof(int)
+		+ m_valueHash.capacity() * sizeof(Node *)
+		+ m_valueHash.count() * sizeof(Node);
 }
 
+QString ConstNumDictionary::infoDebugText(int index) const
+{
+	return QString(" |%1|").arg(m_valueIndex.at(index));
+}
 
-ConstStrInfo::ConstStrInfo(void)
+// (the values of a free entry are written as zero)
+void ConstNumDictionary::writeInfo(ImageWriter &writer, int index) const
 {
-	// default constructor needed for QVector
+	bool isFree = m_valueIndex.at(index) == -1;
+	writer.writeDouble(isFree ? 0.0 : value(index));
+	writer.writeInt(isFree ? 0 : valueInt(index));
 }
 
-ConstStrInfo::ConstStrInfo(Token *token)
+void ConstNumDictionary::readInfo(ImageReader &reader, int index)
 {
-	m_value = new QString(token->string());
+	double value = reader.readDouble();
+	int valueInt = reader.readInt();
+	m_valueIndex.append(keyHandle(index) == -1 ? -1
+		: addValue(value, valueInt));
 }
 
-ConstStrDictionary::~ConstStrDictionary(void)
+// function to renumber the value indexes of the entries (see compact)
+//
+//   - the values are also renumbered so that the used values are dense
+
+void ConstNumDictionary::compactInfo(const QVector<int> &newIndex, int count)
 {
-	for (int i = 0; i < m_info.count(); i++)
+	for (int index = 0; index < newIndex.count(); index++)
+	{
+		if (newIndex.at(index) != -1)
+		{
+			m_valueIndex[newIndex.at(index)] = m_valueIndex.at(index);
+		}
+	}
+	m_valueIndex.resize(count);
+	m_valueIndex.squeeze();
+
+	QVector<int> newValueIndex(m_value.count(), -1);
+	int valueCount = 0;
+	m_valueHash.clear();
+	for (int valueIndex = 0; valueIndex < m_value.count(); valueIndex++)
 	{
-		delete m_info.at(i).value();
+		if (m_valueUseCount.at(valueIndex) != 0)
+		{
+			double value = m_value.at(valueIndex);
+			quint64 bits;
+			memcpy(&bits, &value, sizeof(bits));
+			m_valueHash.insert(bits, valueCount);
+			newValueIndex[valueIndex] = valueCount;
+			m_value[valueCount] = value;
+			m_valueInt[valueCount] = m_valueInt.at(valueIndex);
+			m_valueUseCount[valueCount] = m_valueUseCount.at(valueIndex);
+			valueCount++;
+		}
 	}
+	m_value.resize(valueCount);
+	m_value.squeeze();
+	m_valueInt.resize(valueCount);
+	m_valueInt.squeeze();
+	m_valueUseCount.resize(valueCount);
+	m_valueUseCount.squeeze();
+	m_valueFreeStack.clear();
+	m_valueFreeStack.squeeze();
+	for (int index = 0; index < count; index++)
+	{
+		m_valueIndex[index] = newValueIndex.at(m_valueIndex.at(index));
+	}
+}
+
+quint32 constNumEncode(ProgramModel *programUnit, Token *token)
+{
+	return programUnit->constNumDictionary()->add(token);
+}
+
+const QString constNumOperandText(const ProgramModel *programUnit,
+	quint32 operand)
+{
+	return programUnit->constNumDictionary()->string(operand);
+}
+
+void constNumRemove(ProgramModel *programUnit, quint32 operand)
+{
+	programUnit->constNumDictionary()->remove(operand);
+}
+
+// small integer constants are held in the operand of an immediate code
+// (only when the constant is entered in the form the value is recreated
+// as, so that the constant can be recreated as entered)
+
+bool constNumIsImmediate(Token *token)
+{
+	return token->valueInt() >= 0 && token->valueInt() < ProgramWide_Operand
+		&& token->string() == QString::number(token->valueInt());
+}
+
+const QString constImmOperandText(const ProgramModel *programUnit,
+	quint32 operand)
+{
+	return QString::number(operand);
 }
 
 
-quint16 constStrEncode(ProgramModel *programUnit, Token *token)
+quint32 constStrEncode(ProgramModel *programUnit, Token *token)
 {
-	return programUnit->constStrDictionary()->add(token, Qt::CaseSensitive);
+	return programUnit->constStrDictionary()->add(token);
 }
 
 const QString constStrOperandText(const ProgramModel *programUnit,
-	quint16 operand)
+	quint32 operand)
 {
 	return programUnit->constStrDictionary()->string(operand);
 }
 
-void constStrRemove(ProgramModel *programUnit, quint16 operand)
+void constStrRemove(ProgramModel *programUnit, quint32 operand)
 {
 	programUnit->constStrDictionary()->remove(operand);
 }
 
+void constStrRecreate(Recreator &recreator, Code code)
+{
+	QString string = recreator.operandText();
+	recreator.push(string.replace('"', "\"\"").prepend('"').append('"'));
+}
+
+
+// STRING CONCATENATION FUNCTIONS
+
+// operand of a concatenation of multiple strings is the number of strings
+
+quint32 catStrsEncode(ProgramModel *programUnit, Token *token)
+{
+	return token->valueInt();
+}
+
+const QString catStrsOperandText(const ProgramModel *programUnit,
+	quint32 operand)
+{
+	return QString::number(operand);
+}
+
+// strings after the first are recreated as the last operand of a
+// concatenation operator, so they get parentheses if they are concatenations
+
+void catStrsRecreate(Recreator &recreator, Code code)
+{
+	int precedence = recreator.table().precedence(code);
+	QString string = recreator.popOperand(precedence, true);
+	for (int count = recreator.operand(); --count > 1;)
+	{
+		string.prepend(recreator.popOperand(precedence, true) + " + ");
+	}
+	string.prepend(recreator.popOperand(precedence, false) + " + ");
+	recreator.push(string, precedence);
+}
+
 
 // VARIABLE FUNCTIONS
 
-quint16 varDblEncode(ProgramModel *programUnit, Token *token)
+quint32 varDblEncode(ProgramModel *programUnit, Token *token)
 {
 	return programUnit->varDblDictionary()->add(token);
 }
 
-quint16 varIntEncode(ProgramModel *programUnit, Token *token)
+quint32 varIntEncode(ProgramModel *programUnit, Token *token)
 {
 	return programUnit->varIntDictionary()->add(token);
 }
 
-quint16 varStrEncode(ProgramModel *programUnit, Token *token)
+quint32 varStrEncode(ProgramModel *programUnit, Token *token)
 {
 	return programUnit->varStrDictionary()->add(token);
 }
 
 
 const QString varDblOperandText(const ProgramModel *programUnit,
-	quint16 operand)
+	quint32 operand)
 {
 	return programUnit->varDblDictionary()->string(operand);
 }
 
 const QString varIntOperandText(const ProgramModel *programUnit,
-	quint16 operand)
+	quint32 operand)
 {
 	return programUnit->varIntDictionary()->string(operand);
 }
 
 const QString varStrOperandText(const ProgramModel *programUnit,
-	quint16 operand)
+	quint32 operand)
 {
 	return programUnit->varStrDictionary()->string(operand);
 }
 
 
-void varDblRemove(ProgramModel *programUnit, quint16 operand)
+void varDblRemove(ProgramModel *programUnit, quint32 operand)
 {
 	programUnit->varDblDictionary()->remove(operand);
 }
 
-void varIntRemove(ProgramModel *programUnit, quint16 operand)
+void varIntRemove(ProgramModel *programUnit, quint32 operand)
 {
 	programUnit->varIntDictionary()->remove(operand);
 }
 
-void varStrRemove(ProgramModel *programUnit, quint16 operand)
+void varStrRemove(ProgramModel *programUnit, quint32 operand)
 {
 	programUnit->varStrDictionary()->remove(operand);
 }
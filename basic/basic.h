@@ -25,6 +25,7 @@
 #ifndef BASIC_H
 #define BASIC_H
 
+#include <QHash>
 #include <QString>
 
 #include "ibcp.h"
@@ -33,52 +34,142 @@
 class Translator;
 class Token;
 class ProgramModel;
+class Recreator;
 
 
 // constant definitions
 
-class ConstNumInfo
+// class for the dictionary of number constants
+//
+//   - entries are keyed by the text of the constant as entered (so the
+//     constant is recreated as entered) and the operand of the code is the
+//     index of the entry
+//   - each different value is only held once (constants entered in a
+//     different form with the same value, like 1, 1.0 and 1E0, share their
+//     value), each entry holds the index of its value
+//   - the double and integer values are held in dense arrays that can be
+//     indexed directly by the value index
+//   - values have a use count of the entries using them and a free stack
+
+class ConstNumDictionary : public Dictionary
 {
-	double m_value;
-	int m_valueInt;
-
 public:
-	ConstNumInfo(void);
-	ConstNumInfo(Token *token);
+	explicit ConstNumDictionary(StringArena *strings) :
+		Dictionary(strings) {}
 
-	double value(void) const
+	quint32 add(Token *token);
+	void remove(quint32 index);
+
+	// value access functions
+	int valueIndex(int index) const
+	{
+		return m_valueIndex.at(index);
+	}
+	double value(int index) const
+	{
+		return m_value.at(m_valueIndex.at(index));
+	}
+	int valueInt(int index) const
+	{
+		return m_valueInt.at(m_valueIndex.at(index));
+	}
+	const int *valueIndexes(void) const
+	{
+		return m_valueIndex.constData();
+	}
+	const double *values(void) const
 	{
-		return m_value;
+		return m_value.constData();
 	}
-	int valueInt(void) const
+	const qint32 *valueInts(void) const
 	{
-		return m_valueInt;
+		return m_valueInt.constData();
 	}
+
+	int infoMemory(void) const;
+
+protected:
+	QString infoDebugText(int index) const;
+	void writeInfo(ImageWriter &writer, int index) const;
+	void readInfo(ImageReader &reader, int index);
+	void compactInfo(const QVector<int> &newIndex, int count);
+
+private:
+	int addValue(double value, int valueInt);
+
+	QVector<int> m_valueIndex;			// value index of each entry
+	QVector<double> m_value;			// double values
+	QVector<qint32> m_valueInt;			// integer values
+	QVector<int> m_valueUseCount;		// use count of each value
+	QStack<int> m_valueFreeStack;		// stack of free values
+	QHash<quint64, int> m_valueHash;	// hash of value bits to value index
 };
 
 
-class ConstStrInfo
-{
-	QString *m_value;
+// class for the dictionary of string constants
+//
+//   - the value of a string constant is its key, which is already held in
+//     the string arena of the program, so no other information is held
+//   - the value refers to the characters in the arena (it is not copied)
 
+class ConstStrDictionary : public Dictionary
+{
 public:
-	ConstStrInfo(void);
-	ConstStrInfo(Token *token);
+	explicit ConstStrDictionary(StringArena *strings) :
+		Dictionary(strings, Qt::CaseSensitive) {}
 
-	QString *value(void) const
+	QString value(int index) const
 	{
-		return m_value;
+		return strings()->rawString(keyHandle(index));
 	}
 };
 
 
-class ConstStrDictionary : public InfoDictionary<ConstStrInfo>
+// print constant definitions
+
+// class for the dictionary of print constants
+//
+//   - the value of a print constant (the text printed) is also held in the
+//     string arena of the program, so the keys and values of the constants
+//     are held together in one block (instead of a block for each value)
+//   - the value of an entry is added when the entry is added or reused
+//     (from the free stack), its space is freed when the entry is removed
+//   - the value refers to the characters in the arena (it is not copied)
+
+class PrintConstDictionary : public Dictionary
 {
 public:
-	~ConstStrDictionary(void);
+	explicit PrintConstDictionary(StringArena *strings) :
+		Dictionary(strings, Qt::CaseSensitive) {}
+
+	quint32 add(Token *token);
+	void remove(quint32 index);
+	QString value(int index) const
+	{
+		return strings()->rawString(m_valueHandle.at(index));
+	}
+
+	void moveKeys(StringArena *strings);
+	int infoMemory(void) const
+	{
+		return m_valueHandle.capacity() * sizeof(int);
+	}
+
+protected:
+	QString infoDebugText(int index) const;
+	void writeInfo(ImageWriter &writer, int index) const;
+	void readInfo(ImageReader &reader, int index);
+	void compactInfo(const QVector<int> &newIndex, int count);
+
+private:
+	QVector<int> m_valueHandle;			// arena handles of values
 };
 
 
+// print functions
+QString printNumberText(double value);
+
+
 // translate functions
 TokenStatus inputTranslate(Translator &translator, Token *commandToken,
 	Token *&token);
@@ -89,35 +180,66 @@ TokenStatus printTranslate(Translator &translator, Token *commandToken,
 
 
 // encode functions
-quint16 remEncode(ProgramModel *programUnit, Token *token);
-quint16 constNumEncode(ProgramModel *programUnit, Token *token);
-quint16 constStrEncode(ProgramModel *programUnit, Token *token);
-quint16 varDblEncode(ProgramModel *programUnit, Token *token);
-quint16 varIntEncode(ProgramModel *programUnit, Token *token);
-quint16 varStrEncode(ProgramModel *programUnit, Token *token);
+quint32 remEncode(ProgramModel *programUnit, Token *token);
+quint32 constNumEncode(ProgramModel *programUnit, Token *token);
+quint32 constStrEncode(ProgramModel *programUnit, Token *token);
+quint32 varDblEncode(ProgramModel *programUnit, Token *token);
+quint32 varIntEncode(ProgramModel *programUnit, Token *token);
+quint32 varStrEncode(ProgramModel *programUnit, Token *token);
+quint32 catStrsEncode(ProgramModel *programUnit, Token *token);
+quint32 printConstEncode(ProgramModel *programUnit, Token *token);
+
+
+// immediate constant functions
+bool constNumIsImmediate(Token *token);
 
 
 // operand text functions
-const QString remOperandText(const ProgramModel *programUnit, quint16 operand);
+const QString remOperandText(const ProgramModel *programUnit, quint32 operand);
 const QString constNumOperandText(const ProgramModel *programUnit,
-	quint16 operand);
+	quint32 operand);
+const QString constImmOperandText(const ProgramModel *programUnit,
+	quint32 operand);
 const QString constStrOperandText(const ProgramModel *programUnit,
-	quint16 operand);
+	quint32 operand);
 const QString varDblOperandText(const ProgramModel *programUnit,
-	quint16 operand);
+	quint32 operand);
 const QString varIntOperandText(const ProgramModel *programUnit,
-	quint16 operand);
+	quint32 operand);
 const QString varStrOperandText(const ProgramModel *programUnit,
-	quint16 operand);
+	quint32 operand);
+const QString catStrsOperandText(const ProgramModel *programUnit,
+	quint32 operand);
+const QString printConstOperandText(const ProgramModel *programUnit,
+	quint32 operand);
 
 
 // remove functions
-void remRemove(ProgramModel *programUnit, quint16 operand);
-void constNumRemove(ProgramModel *programUnit, quint16 operand);
-void constStrRemove(ProgramModel *programUnit, quint16 operand);
-void varDblRemove(ProgramModel *programUnit, quint16 operand);
-void varIntRemove(ProgramModel *programUnit, quint16 operand);
-void varStrRemove(ProgramModel *programUnit, quint16 operand);
+void remRemove(ProgramModel *programUnit, quint32 operand);
+void constNumRemove(ProgramModel *programUnit, quint32 operand);
+void constStrRemove(ProgramModel *programUnit, quint32 operand);
+void varDblRemove(ProgramModel *programUnit, quint32 operand);
+void varIntRemove(ProgramModel *programUnit, quint32 operand);
+void varStrRemove(ProgramModel *programUnit, quint32 operand);
+void printConstRemove(ProgramModel *programUnit, quint32 operand);
+
+
+// recreate functions
+void remRecreate(Recreator &recreator, Code code);
+void remOpRecreate(Recreator &recreator, Code code);
+void constStrRecreate(Recreator &recreator, Code code);
+void catStrsRecreate(Recreator &recreator, Code code);
+void assignRecreate(Recreator &recreator, Code code);
+void assignKeepRecreate(Recreator &recreator, Code code);
+void printItemRecreate(Recreator &recreator, Code code);
+void printConstRecreate(Recreator &recreator, Code code);
+void printFunctionRecreate(Recreator &recreator, Code code);
+void printCommaRecreate(Recreator &recreator, Code code);
+void printSemicolonRecreate(Recreator &recreator, Code code);
+void printRecreate(Recreator &recreator, Code code);
+void inputPromptBeginRecreate(Recreator &recreator, Code code);
+void inputAssignRecreate(Recreator &recreator, Code code);
+void inputRecreate(Recreator &recreator, Code code);
 
 
 #endif // BASIC_H
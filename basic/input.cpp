@@ -22,6 +22,7 @@
 //
 //	2013-08-17	initial version
 
+#include "recreator.h"
 #include "table.h"
 #include "token.h"
 #include "translator.h"
@@ -145,4 +146,53 @@ TokenStatus inputTranslate(Translator &translator, Token *commandToken,
 }
 
 
+// INPUT recreate functions
+//
+//   - the prompt and input references of a statement are collected in the
+//     string at the bottom of the stack (the stack only contains the items
+//     of the statement)
+//   - the input prompt is followed by a comma if it has the option sub-code
+//     (question mark), otherwise by a semicolon
+
+void inputPromptBeginRecreate(Recreator &recreator, Code code)
+{
+	QString string = recreator.pop();
+	string.append(recreator.hasSubCode(Option_SubCode) ? ',' : ';');
+	recreator.push(string);
+}
+
+void inputAssignRecreate(Recreator &recreator, Code code)
+{
+	QString string = recreator.pop();
+	if (recreator.stackIsEmpty())
+	{
+		recreator.push(string);
+	}
+	else
+	{
+		if (!recreator.topString().endsWith(',')
+			&& !recreator.topString().endsWith(';'))
+		{
+			recreator.topAppend(",");
+		}
+		recreator.topAppend(string);
+	}
+}
+
+void inputRecreate(Recreator &recreator, Code code)
+{
+	QString string = recreator.table().name(code);
+	if (!recreator.table().name2(code).isEmpty())
+	{
+		string.append(' ' + recreator.table().name2(code));
+	}
+	string.append(' ' + recreator.pop());
+	if (recreator.hasSubCode(Option_SubCode))
+	{
+		string.append(';');  // keep cursor on line
+	}
+	recreator.append(string);
+}
+
+
 // end: input.cpp
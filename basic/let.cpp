@@ -22,6 +22,7 @@
 //
 //	2013-07-06	initial version
 
+#include "recreator.h"
 #include "table.h"
 #include "token.h"
 #include "translator.h"
@@ -196,4 +197,64 @@ TokenStatus letTranslate(Translator &translator, Token *commandToken,
 }
 
 
+// function to pop the reference of an assignment and return its text
+//
+//   - for sub-string assignments, the reference and the arguments are
+//     popped and recreated as the sub-string function
+
+static QString assignReference(Recreator &recreator, Code code)
+{
+	QString name = recreator.table().name(code);
+	if (!name.endsWith('('))
+	{
+		return recreator.pop();  // variable reference
+	}
+
+	QString string = recreator.pop();
+	if (code == AssignMid3_Code || code == AssignKeepMid3_Code)
+	{
+		string.prepend(recreator.pop() + ',');  // has length argument
+	}
+	string.prepend(recreator.pop() + ',');
+	return name + string + ')';
+}
+
+
+// assignment recreate functions
+//
+//   - an assignment keep code leaves its value on the stack with the
+//     references recreated so far in front of it, which is marked with
+//     the precedence of the assignment codes
+//   - the last assignment code of a list assignment pops the rest of the
+//     references (the stack only contains items of the statement)
+
+void assignRecreate(Recreator &recreator, Code code)
+{
+	int precedence = recreator.table().precedence(code);
+	QString separator = recreator.topPrecedence() == precedence ? "," : " = ";
+	QString string = recreator.pop();
+
+	string.prepend(assignReference(recreator, code) + separator);
+	while (!recreator.stackIsEmpty())
+	{
+		string.prepend(recreator.pop() + ',');
+	}
+	if (recreator.hasSubCode(Option_SubCode))
+	{
+		string.prepend(recreator.table().optionName(code) + ' ');
+	}
+	recreator.append(string);
+}
+
+void assignKeepRecreate(Recreator &recreator, Code code)
+{
+	int precedence = recreator.table().precedence(code);
+	QString separator = recreator.topPrecedence() == precedence ? "," : " = ";
+	QString string = recreator.pop();
+
+	string.prepend(assignReference(recreator, code) + separator);
+	recreator.push(string, precedence);
+}
+
+
 // end: let.cpp
@@ -22,6 +22,9 @@
 //
 //	2013-08-03	initial version
 
+#include "programimage.h"
+#include "programmodel.h"
+#include "recreator.h"
 #include "table.h"
 #include "token.h"
 #include "translator.h"
@@ -135,4 +138,223 @@ TokenStatus printTranslate(Translator &translator, Token *commandToken,
 }
 
 
+// function to return the text printed for a number
+//
+//   - a space is printed in place of the sign for non-negative numbers
+//   - numbers are always followed by a space
+//   - negative zero is printed as zero (the same as a zero constant)
+
+QString printNumberText(double value)
+{
+	if (value == 0)
+	{
+		value = 0;  // (drop the sign of negative zero)
+	}
+	QString string = QString::number(value, 'g', 15);
+	if (value >= 0)
+	{
+		string.prepend(' ');
+	}
+	return string + ' ';
+}
+
+
+// PRINT CONSTANT FUNCTIONS
+
+// the key of a print constant is the text of a run of constant print items
+// separated by semicolons (string constants in quotes), which is needed to
+// recreate the items; the information is the text printed by the items
+
+// function to return the text printed by the items of a print constant
+static QString printConstValue(const QString &items)
+{
+	QString value;
+	int pos = 0;
+	while (pos < items.length())
+	{
+		if (items.at(pos) == '"')  // string constant?
+		{
+			while (++pos < items.length())
+			{
+				if (items.at(pos) == '"' && (++pos >= items.length()
+					|| items.at(pos) != '"'))
+				{
+					break;  // end of string (not a double quote)
+				}
+				value.append(items.at(pos));
+			}
+		}
+		else  // numeric constant
+		{
+			int end = items.indexOf(';', pos);
+			if (end == -1)
+			{
+				end = items.length();
+			}
+			value.append(printNumberText(items.mid(pos, end - pos)
+				.toDouble()));
+			pos = end;
+		}
+		pos++;  // skip semicolon
+	}
+	return value;
+}
+
+quint32 PrintConstDictionary::add(Token *token)
+{
+	EntryType returnNewEntry;
+	int index = Dictionary::add(token, &returnNewEntry);
+	if (returnNewEntry != Exists_Entry)
+	{
+		int handle = strings()->add(printConstValue(token->string()));
+		if (returnNewEntry == New_Entry)
+		{
+			m_valueHandle.append(handle);
+		}
+		else  // Reused_Entry
+		{
+			m_valueHandle[index] = handle;
+		}
+	}
+	return index;
+}
+
+void PrintConstDictionary::remove(quint32 index)
+{
+	Dictionary::remove(index);
+	if (keyHandle(index) == -1)  // entry removed?
+	{
+		strings()->remove(m_valueHandle.at(index));
+		m_valueHandle[index] = -1;
+	}
+}
+
+void PrintConstDictionary::moveKeys(StringArena *strings)
+{
+	for (int index = 0; index < m_valueHandle.count(); index++)
+	{
+		int handle = m_valueHandle.at(index);
+		if (handle != -1)
+		{
+			m_valueHandle[index] = strings->add(this->strings()->data(handle),
+				this->strings()->length(handle));
+		}
+	}
+	Dictionary::moveKeys(strings);
+}
+
+QString PrintConstDictionary::infoDebugText(int index) const
+{
+	return QString(" |%1|").arg(value(index));
+}
+
+// (the value of a free entry is written as a null string)
+void PrintConstDictionary::writeInfo(ImageWriter &writer, int index) const
+{
+	int handle = m_valueHandle.at(index);
+	writer.writeString(handle == -1 ? QString() : value(index));
+}
+
+void PrintConstDictionary::readInfo(ImageReader &reader, int index)
+{
+	QString value = reader.readString();
+	m_valueHandle.append(keyHandle(index) == -1 ? -1 : strings()->add(value));
+}
+
+void PrintConstDictionary::compactInfo(const QVector<int> &newIndex, int count)
+{
+	for (int index = 0; index < newIndex.count(); index++)
+	{
+		if (newIndex.at(index) != -1)
+		{
+			m_valueHandle[newIndex.at(index)] = m_valueHandle.at(index);
+		}
+	}
+	m_valueHandle.resize(count);
+	m_valueHandle.squeeze();
+}
+
+
+quint32 printConstEncode(ProgramModel *programUnit, Token *token)
+{
+	return programUnit->printConstDictionary()->add(token);
+}
+
+const QString printConstOperandText(const ProgramModel *programUnit,
+	quint32 operand)
+{
+	return programUnit->printConstDictionary()->string(operand);
+}
+
+void printConstRemove(ProgramModel *programUnit, quint32 operand)
+{
+	programUnit->printConstDictionary()->remove(operand);
+}
+
+
+// PRINT RECREATE FUNCTIONS
+
+// the print items of a statement are collected in the string at the bottom
+// of the stack (the stack only contains the items of the statement), where
+// print items not separated by a comma are separated by a semicolon
+
+static void printItemAppend(Recreator &recreator, const QString &string)
+{
+	if (recreator.stackIsEmpty())
+	{
+		recreator.push(string);
+	}
+	else
+	{
+		if (!recreator.topString().isEmpty()
+			&& !recreator.topString().endsWith(','))
+		{
+			recreator.topAppend(";");
+		}
+		recreator.topAppend(string);
+	}
+}
+
+void printItemRecreate(Recreator &recreator, Code code)
+{
+	printItemAppend(recreator, recreator.pop());
+}
+
+void printConstRecreate(Recreator &recreator, Code code)
+{
+	printItemAppend(recreator, recreator.operandText());
+}
+
+void printFunctionRecreate(Recreator &recreator, Code code)
+{
+	printItemAppend(recreator, recreator.table().name(code) + recreator.pop()
+		+ ')');
+}
+
+void printCommaRecreate(Recreator &recreator, Code code)
+{
+	if (recreator.stackIsEmpty())
+	{
+		recreator.push("");
+	}
+	recreator.topAppend(recreator.table().name(code));
+}
+
+void printSemicolonRecreate(Recreator &recreator, Code code)
+{
+	recreator.topAppend(recreator.table().name(code));
+	printRecreate(recreator, Print_Code);
+}
+
+void printRecreate(Recreator &recreator, Code code)
+{
+	QString string = recreator.table().name(code);
+	if (!recreator.stackIsEmpty())
+	{
+		string.append(' ' + recreator.pop());
+	}
+	recreator.append(string);
+}
+
+
 // end: print.cpp
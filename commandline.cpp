@@ -22,10 +22,13 @@
 //
 //	2012-11-25	initial version
 
+#include <QFile>
 #include <QFileInfo>
 
 #include "ibcp_config.h"  // for cmake
 #include "commandline.h"
+#include "programmodel.h"
+#include "registerrunner.h"
 #include "test_ibcp.h"
 
 
@@ -52,6 +55,8 @@ CommandLine::CommandLine(const QStringList &args)
 	// create usage string
 	QStringList options = Tester::options();
 	// append any other options here
+	options << QString("-m <%1>").arg(tr("program file"));
+	options << QString("-r [-reg] <%1>").arg(tr("program file"));
 	options.prepend("<program file>|-h|-?|-v");
 	m_usage = tr("usage: %1 [%2]").arg(m_programName).arg(options.join("|"));
 
@@ -68,6 +73,16 @@ CommandLine::CommandLine(const QStringList &args)
 		return;
 	}
 
+	if (isMemoryOption(args))
+	{
+		return;
+	}
+
+	if (isRunOption(args))
+	{
+		return;
+	}
+
 	Tester tester(args);
 	if (tester.hasError())
 	{
@@ -147,6 +162,85 @@ bool CommandLine::isVersionOption(const QStringList &args)
 }
 
 
+// function to check if memory option was specified and to process it
+//
+//   - the program file is loaded (as it would be into the edit box) and a
+//     report of the memory used by the program is output
+
+bool CommandLine::isMemoryOption(const QStringList &args)
+{
+	if (args.count() != 3 || args.at(1) != "-m")
+	{
+		return false;  // not our option or extra/invalid options
+	}
+	QFile file(args.at(2));
+	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+	{
+		cout(stderr) << tr("%1: error opening '%2'").arg(m_programName)
+			.arg(args.at(2)) << endl;
+		m_returnCode = 1;
+		return true;
+	}
+	QTextStream input(&file);
+	QString text = input.readAll();
+
+	ProgramModel programModel;
+	programModel.load(text.isEmpty() ? QStringList() : text.split('\n'));
+	cout() << programModel.memoryStats();
+	m_returnCode = 0;
+	return true;
+}
+
+
+// function to check if run option was specified and to process it
+//
+//   - the program file is loaded and run without the GUI (the program
+//     output is to standard output and input is from standard input)
+//   - the program code is run, or the register code lowered from the
+//     program code if the register option is specified (for comparing the
+//     run times of the two codes)
+
+bool CommandLine::isRunOption(const QStringList &args)
+{
+	bool registerCode = args.count() == 4 && args.at(2) == "-reg";
+	if (args.count() != (registerCode ? 4 : 3) || args.at(1) != "-r")
+	{
+		return false;  // not our option or extra/invalid options
+	}
+	QFile file(args.last());
+	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+	{
+		cout(stderr) << tr("%1: error opening '%2'").arg(m_programName)
+			.arg(args.last()) << endl;
+		m_returnCode = 1;
+		return true;
+	}
+	QTextStream input(&file);
+	QString text = input.readAll();
+
+	ProgramModel programModel;
+	programModel.load(text.isEmpty() ? QStringList() : text.split('\n'));
+	Runner *runner = registerCode
+		? new RegisterRunner(programModel.snapshot())
+		: new Runner(programModel.snapshot());
+	QFile standardInput;
+	standardInput.open(stdin, QIODevice::ReadOnly);
+	QTextStream programInput(&standardInput);
+	bool ran = runner->run(cout(), programInput);
+	QString errorMessage = runner->errorMessage();
+	delete runner;
+	if (!ran)
+	{
+		coutClose();  // close stdout
+		cout(stderr) << errorMessage << endl;
+		m_returnCode = 1;
+		return true;
+	}
+	m_returnCode = 0;
+	return true;
+}
+
+
 // function to check for help options
 bool CommandLine::isHelpOption(const QStringList &args) const
 {
@@ -36,6 +36,8 @@ class CommandLine
 	QTextStream &cout(FILE *stream = stdout);
 	void coutClose(void);
 	bool isVersionOption(const QStringList &args);
+	bool isMemoryOption(const QStringList &args);
+	bool isRunOption(const QStringList &args);
 	bool isHelpOption(const QStringList &args) const;
 
 	static const char *s_copyrightStatement;
@@ -23,41 +23,139 @@
 //	2013-09-27	initial version
 
 #include "dictionary.h"
+#include "programimage.h"
 #include "token.h"
 
 
-Dictionary::Dictionary(void)
+//=========================
+//  STRING ARENA FUNCTIONS
+//=========================
+
+// function to add a string to the arena and return its handle
+int StringArena::add(const QChar *data, int length)
 {
+	int handle = m_data.length();
+	m_data.append(QChar(length & 0xffff)).append(QChar(length >> 16))
+		.append(QString::fromRawData(data, length));
+	return handle;
 }
 
 
-quint16 Dictionary::add(Token *token, Qt::CaseSensitivity cs,
-	Dictionary::EntryType *returnNewEntry)
+//=======================
+//  DICTIONARY FUNCTIONS
+//=======================
+
+// function to calculate the hash of a key
+//
+//   - for case insensitive keys, the case of each character is folded so
+//     that keys that compare equal have the same hash
+//   - the bits of the hash are mixed at the end since the slot is the low
+//     bits of the hash (the low bits are otherwise only from the last few
+//     characters, so keys like A1, A2, ... would cluster in the table)
+
+static uint keyHash(const QChar *c, int length, Qt::CaseSensitivity cs)
+{
+	uint hash = 0;
+	for (; --length >= 0; c++)
+	{
+		hash = (hash << 4) + (cs == Qt::CaseInsensitive
+			? c->toCaseFolded().unicode() : c->unicode());
+		hash ^= (hash & 0xf0000000) >> 23;
+		hash &= 0x0fffffff;
+	}
+	hash *= 0x9e3779b1u;  // (golden ratio multiplier)
+	return hash ^ hash >> 15;
+}
+
+
+// function to compare a key to a string
+static bool keyEqual(const QChar *key, int length, const QString &string,
+	Qt::CaseSensitivity cs)
+{
+	if (length != string.length())
+	{
+		return false;
+	}
+	const QChar *c = string.unicode();
+	for (int i = 0; i < length; i++)
+	{
+		if (cs == Qt::CaseInsensitive ? key[i].toCaseFolded()
+			!= c[i].toCaseFolded() : key[i] != c[i])
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+Dictionary::Dictionary(StringArena *strings, Qt::CaseSensitivity cs) :
+	m_strings(strings),
+	m_caseSensitivity(cs),
+	m_hashTable(MinimumHashSize, EmptySlot),
+	m_hashUsed(0)
+{
+}
+
+
+// function to find the entry of a key
+//
+//   - the hash and compare of the key fold the case of the characters if
+//     the dictionary is case insensitive
+//   - returns the index of the entry or -1 if the key is not present
+//   - the dictionary is not changed (see class description)
+
+int Dictionary::find(const QString &string) const
+{
+	uint mask = m_hashTable.size() - 1;
+	uint slot = keyHash(string.unicode(), string.length(), m_caseSensitivity)
+		& mask;
+	int index;
+	while ((index = m_hashTable.at(slot)) != EmptySlot)
+	{
+		if (index != RemovedSlot)
+		{
+			int handle = m_keyHandle.at(index);
+			if (keyEqual(m_strings->data(handle), m_strings->length(handle),
+				string, m_caseSensitivity))
+			{
+				return index;
+			}
+		}
+		slot = (slot + 1) & mask;
+	}
+	return -1;
+}
+
+
+// function to add a key or another use of a key already present
+//
+//   - the key is first found without changing the dictionary, the key is
+//     only inserted if not present (first actual string is stored)
+
+quint32 Dictionary::add(Token *token, Dictionary::EntryType *returnNewEntry)
 {
 	EntryType newEntry;
 
-	// if requested, store upper case of key in hash to make search case
-	// insensitive (first actual string will be stored in key list)
-	QString hashKey = cs == Qt::CaseInsensitive
-		? token->string().toUpper() : token->string();
-	int index = m_keyHash.value(hashKey, -1);
+	QString string = token->string();
+	int index = find(string);
 	if (index == -1)  // string not present?
 	{
 		if (m_freeStack.empty())  // no free indexes available?
 		{
-			index = m_keyList.count();
-			m_keyList.append(token->string());
+			index = m_keyHandle.count();
+			m_keyHandle.append(m_strings->add(string));
 			m_useCount.append(1);
 			newEntry = New_Entry;
 		}
 		else  // use a previously freed index
 		{
 			index = m_freeStack.pop();
-			m_keyList[index] = token->string();
+			m_keyHandle[index] = m_strings->add(string);
 			m_useCount[index] = 1;
 			newEntry = Reused_Entry;
 		}
-		m_keyHash[hashKey] = index;  // save key/index in map
+		hashInsert(index);  // save index in hash table
 	}
 	else  // string already present, update use count
 	{
@@ -72,26 +170,113 @@ quint16 Dictionary::add(Token *token, Qt::CaseSensitivity cs,
 }
 
 
-void Dictionary::remove(quint16 index)
+void Dictionary::remove(quint32 index)
 {
 	if (--m_useCount[index] == 0)  // update use count, if zero then remove it
 	{
-		m_keyHash.remove(m_keyList.at(index));  // remove key/index from map
-		m_keyList[index].clear();
+		// remove index from hash table (mark slot as removed so that the
+		// entries after it are still found)
+		uint mask = m_hashTable.size() - 1;
+		uint slot = entryHash(index) & mask;
+		while (m_hashTable.at(slot) != (int)index)
+		{
+			slot = (slot + 1) & mask;
+		}
+		m_hashTable[slot] = RemovedSlot;
+
+		m_strings->remove(m_keyHandle.at(index));
+		m_keyHandle[index] = -1;
 		m_freeStack.push(index);
-    }
+	}
+}
+
+
+// function to calculate the hash of the key of an entry
+uint Dictionary::entryHash(int index) const
+{
+	int handle = m_keyHandle.at(index);
+	return keyHash(m_strings->data(handle), m_strings->length(handle),
+		m_caseSensitivity);
+}
+
+
+// function to insert the index of a new entry into the hash table
+//
+//   - the first empty or removed slot is used (the key is not present)
+//   - the hash table is rebuilt instead if it would be more than half full
+
+void Dictionary::hashInsert(int index)
+{
+	if ((m_hashUsed + 1) * 2 > m_hashTable.size())
+	{
+		rehash();  // (also inserts the new entry)
+		return;
+	}
+	uint mask = m_hashTable.size() - 1;
+	uint slot = entryHash(index) & mask;
+	while (m_hashTable.at(slot) >= 0)
+	{
+		slot = (slot + 1) & mask;
+	}
+	if (m_hashTable.at(slot) == EmptySlot)
+	{
+		m_hashUsed++;
+	}
+	m_hashTable[slot] = index;
+}
+
+
+// function to rebuild the hash table without the removed slots
+//
+//   - the size is set so that the entries fill at most a quarter of the
+//     table (so the table is not rebuilt again soon after)
+
+void Dictionary::rehash(void)
+{
+	int count = m_keyHandle.count() - m_freeStack.count();
+	int size = MinimumHashSize;
+	while (size < (count + 1) * 4)
+	{
+		size *= 2;
+	}
+	m_hashTable.fill(EmptySlot, size);
+	m_hashUsed = 0;
+	for (int index = 0; index < m_keyHandle.count(); index++)
+	{
+		if (m_keyHandle.at(index) != -1)
+		{
+			hashInsert(index);
+		}
+	}
+}
+
+
+// function to move the keys of the entries to another string arena
+void Dictionary::moveKeys(StringArena *strings)
+{
+	for (int index = 0; index < m_keyHandle.count(); index++)
+	{
+		int handle = m_keyHandle.at(index);
+		if (handle != -1)
+		{
+			m_keyHandle[index] = strings->add(m_strings->data(handle),
+				m_strings->length(handle));
+		}
+	}
+	m_strings = strings;
 }
 
 
 QString Dictionary::debugText(const QString header)
 {
 	QString string = QString("\n%1:\n").arg(header);
-	for (int i = 0; i < m_keyList.count(); i++)
+	for (int i = 0; i < m_keyHandle.count(); i++)
 	{
 		if (m_useCount.at(i) != 0)
 		{
-			string.append(QString("%1: %2 |%3|\n").arg(i).arg(m_useCount.at(i))
-				.arg(m_keyList.at(i)));
+			string.append(QString("%1: %2 |%3|%4\n").arg(i)
+				.arg(m_useCount.at(i)).arg(this->string(i))
+				.arg(infoDebugText(i)));
 		}
 	}
 	string.append("Free:");
@@ -109,9 +294,9 @@ QString Dictionary::debugText(const QString header)
 			{
 				string.append(QString("'%1'").arg(m_useCount.at(index)));
 			}
-			if (!m_keyList.at(index).isEmpty())
+			if (m_keyHandle.at(index) != -1)
 			{
-				string.append(QString("|%1|").arg(m_keyList.at(index)));
+				string.append(QString("|%1|").arg(this->string(index)));
 			}
 		}
 	}
@@ -120,4 +305,124 @@ QString Dictionary::debugText(const QString header)
 }
 
 
+// function to return the memory of the key handles
+//
+//   - the keys are in the string arena of the program
+
+int Dictionary::keyMemory(void) const
+{
+	return m_keyHandle.capacity() * sizeof(int);
+}
+
+
+// function to return the memory of the hash table
+int Dictionary::hashMemory(void) const
+{
+	return m_hashTable.capacity() * sizeof(int);
+}
+
+
+// function to return the memory of the use counts and the free stack
+int Dictionary::useCountMemory(void) const
+{
+	return m_useCount.capacity() * sizeof(quint32)
+		+ m_freeStack.capacity() * sizeof(quint32);
+}
+
+
+// function to renumber the entries so that the used entries are dense
+//
+//   - the used entries keep their order and the free entries are dropped,
+//     the lists of the entries and the hash table are shrunk to fit
+//   - returns the new index of each old entry (-1 for free entries) so the
+//     operands of the code can be renumbered, or an empty vector if there
+//     were no free entries (no entries were renumbered)
+
+QVector<int> Dictionary::compact(void)
+{
+	if (m_freeStack.isEmpty())
+	{
+		return QVector<int>();
+	}
+	QVector<int> newIndex(m_keyHandle.count(), -1);
+	int count = 0;
+	for (int index = 0; index < m_keyHandle.count(); index++)
+	{
+		if (m_keyHandle.at(index) != -1)
+		{
+			newIndex[index] = count;
+			m_keyHandle[count] = m_keyHandle.at(index);
+			m_useCount[count] = m_useCount.at(index);
+			count++;
+		}
+	}
+	m_keyHandle.resize(count);
+	m_keyHandle.squeeze();
+	m_useCount.resize(count);
+	m_useCount.squeeze();
+	m_freeStack.clear();
+	m_freeStack.squeeze();
+	compactInfo(newIndex, count);
+	rehash();
+	m_hashTable.squeeze();
+	return newIndex;
+}
+
+
+// function to write the entries of the dictionary to a program image
+void Dictionary::writeImage(ImageWriter &writer) const
+{
+	writer.writeInt(m_keyHandle.count());
+	for (int i = 0; i < m_keyHandle.count(); i++)
+	{
+		writer.writeInt(m_useCount.at(i));
+		writer.writeString(string(i));
+		writeInfo(writer, i);
+	}
+	writer.writeInt(m_freeStack.count());
+	for (int i = 0; i < m_freeStack.count(); i++)
+	{
+		writer.writeInt(m_freeStack.at(i));
+	}
+}
+
+
+// function to read the entries of an empty dictionary from a program image
+//
+//   - the hash of the keys is rebuilt with the case sensitivity of the
+//     dictionary (which must be the same as when the image was written)
+//   - returns false if the image is invalid
+
+bool Dictionary::readImage(ImageReader &reader)
+{
+	int count = reader.readCount(2 * sizeof(quint32));
+	for (int i = 0; i < count; i++)
+	{
+		m_useCount.append(reader.readInt());
+		QString key = reader.readString();
+		if (m_useCount.at(i) == 0)
+		{
+			m_keyHandle.append(-1);  // free entry
+		}
+		else
+		{
+			m_keyHandle.append(m_strings->add(key));
+			hashInsert(i);
+		}
+		readInfo(reader, i);
+	}
+	int freeCount = reader.readCount(sizeof(quint32));
+	for (int i = 0; i < freeCount; i++)
+	{
+		quint32 index = reader.readInt();
+		if (index >= (quint32)count || m_useCount.at(index) != 0)
+		{
+			return false;  // invalid free entry
+		}
+		m_freeStack.push(index);
+	}
+	return !reader.hasError();
+}
+
+
 // end: dictionary.cpp
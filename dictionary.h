@@ -25,17 +25,103 @@
 #ifndef DICTIONARY_H
 #define DICTIONARY_H
 
-#include <QHash>
 #include <QStack>
-#include <QStringList>
+#include <QString>
+#include <QVector>
+
+#include "ibcp.h"
 
 class Token;
+class ImageReader;
+class ImageWriter;
+
+
+// class for holding the key strings of the dictionaries of a program
+//
+//   - the strings are held one after the other in one array of characters
+//     (instead of each string in its own allocated block), where a string
+//     is identified by its handle (its offset in the array)
+//   - each string is preceded by its length (in two characters)
+//   - the space of a removed string is not reused, but is counted so that
+//     the program can compact the arena when it is mostly unused space
+//     (by moving the keys of its dictionaries to a new arena)
+//   - the array is implicitly shared, so copying an arena is inexpensive
+
+class StringArena
+{
+public:
+	StringArena(void) : m_unused(0) {}
+
+	int add(const QChar *data, int length);
+	int add(const QString &string)
+	{
+		return add(string.unicode(), string.length());
+	}
+	void remove(int handle)
+	{
+		m_unused += LengthSize + length(handle);
+	}
+	int length(int handle) const
+	{
+		const QChar *data = m_data.unicode() + handle;
+		return data[0].unicode() | data[1].unicode() << 16;
+	}
+	const QChar *data(int handle) const
+	{
+		return m_data.unicode() + handle + LengthSize;
+	}
+	QString string(int handle) const
+	{
+		return QString(data(handle), length(handle));
+	}
+	// (the raw string refers to the characters in the arena, so it is only
+	// valid until the arena is changed, the arena of a snapshot is not)
+	QString rawString(int handle) const
+	{
+		return QString::fromRawData(data(handle), length(handle));
+	}
+	bool isFragmented(void) const
+	{
+		return m_unused >= MinimumUnused && m_unused * 2 > m_data.length();
+	}
+	int memory(void) const
+	{
+		return sizeof(StringArena) - sizeof(QString) + stringMemory(m_data);
+	}
 
+private:
+	enum {
+		LengthSize = 2,					// characters holding length
+		MinimumUnused = 1024			// unused characters before compact
+	};
+
+	QString m_data;						// characters of the strings
+	int m_unused;						// characters of removed strings
+};
+
+
+// class for holding a dictionary of a program
+//
+//   - the keys are held in the string arena of the program, each entry
+//     holds the handle of its key (so each key is only held once)
+//   - entries are found with an open addressing hash table of the indexes
+//     of the entries (linear probing), where the hash and compare of the
+//     keys fold the case of the characters for case insensitive keys
+//     (so finding an entry that is already present does not allocate)
+//   - the hash table is kept at most half full (including the slots of
+//     removed entries), it is rebuilt when it would be more than half full
+//   - a dictionary is not synchronized, it must only be changed by one
+//     thread (the thread encoding the program), but the const functions
+//     (find, string and the value functions of the derived dictionaries)
+//     can be called by any number of threads at once for a dictionary
+//     that is not being changed (like the dictionaries of a snapshot)
 
 class Dictionary
 {
 public:
-	Dictionary(void);
+	explicit Dictionary(StringArena *strings,
+		Qt::CaseSensitivity cs = Qt::CaseInsensitive);
+	virtual ~Dictionary(void) {}
 
 	enum EntryType
 	{
@@ -45,45 +131,86 @@ public:
 		sizeof_Entry
 	};
 
-	quint16 add(Token *token, Qt::CaseSensitivity cs = Qt::CaseInsensitive,
-		EntryType *returnNewEntry = NULL);
-	void remove(quint16 index);
+	int find(const QString &string) const;
+	quint32 add(Token *token, EntryType *returnNewEntry = NULL);
+	void remove(quint32 index);
 	QString string(int index) const
 	{
-		return m_keyList.at(index);
+		int handle = m_keyHandle.at(index);
+		return handle == -1 ? QString() : m_strings->string(handle);
+	}
+	int count(void) const
+	{
+		// (number of entry indexes including removed entries)
+		return m_keyHandle.count();
+	}
+	quint32 useCount(int index) const
+	{
+		// (the use count of a removed entry is zero)
+		return m_useCount.at(index);
 	}
 	QString debugText(const QString header);
 
-private:
-	QStack<quint16> m_freeStack;		// stack of free items
-	QStringList m_keyList;				// list of keys
-	QHash<QString, int> m_keyHash;		// hash map of keys to indexes
-	QList<quint16> m_useCount;			// list of key use counts
-};
+	// string arena functions
+	void setStrings(StringArena *strings)
+	{
+		m_strings = strings;
+	}
+	virtual void moveKeys(StringArena *strings);
 
+	QVector<int> compact(void);
+
+	// memory functions (in bytes, estimated)
+	int keyMemory(void) const;
+	int hashMemory(void) const;
+	int useCountMemory(void) const;
+	virtual int infoMemory(void) const
+	{
+		return 0;
+	}
+
+	void writeImage(ImageWriter &writer) const;
+	bool readImage(ImageReader &reader);
 
-template <class Info>
-// Info class must have Info(Token *token) constructor
-class InfoDictionary : public Dictionary
-{
 protected:
-	QVector<Info> m_info;				// additional dictionary information
+	StringArena *strings(void) const
+	{
+		return m_strings;
+	}
+	int keyHandle(int index) const
+	{
+		return m_keyHandle.at(index);
+	}
 
-public:
-	quint16 add(Token *token, Qt::CaseSensitivity cs = Qt::CaseInsensitive)
-	{
-		EntryType returnNewEntry;
-		int index = Dictionary::add(token, cs, &returnNewEntry);
-		if (returnNewEntry == New_Entry)
-		{
-			m_info.append(Info(token));
-		}
-		else if (returnNewEntry == Reused_Entry)
-		{
-			m_info[index] = Info(token);
-		}
-		return index;
+	// function to return debug text of any additional entry information
+	virtual QString infoDebugText(int index) const
+	{
+		return QString();
 	}
+	// functions to write and read any additional entry information
+	virtual void writeInfo(ImageWriter &writer, int index) const {}
+	virtual void readInfo(ImageReader &reader, int index) {}
+	// function to renumber any additional entry information (see compact)
+	virtual void compactInfo(const QVector<int> &newIndex, int count) {}
+
+private:
+	enum {
+		EmptySlot = -1,					// hash table slot never used
+		RemovedSlot = -2,				// hash table slot of removed entry
+		MinimumHashSize = 16			// minimum size of hash table
+	};
+
+	uint entryHash(int index) const;
+	void hashInsert(int index);
+	void rehash(void);
+
+	StringArena *m_strings;				// string arena holding the keys
+	Qt::CaseSensitivity m_caseSensitivity;	// case sensitivity of keys
+	QStack<quint32> m_freeStack;		// stack of free items
+	QVector<int> m_keyHandle;			// arena handles of keys
+	QVector<int> m_hashTable;			// hash table of entry indexes
+	int m_hashUsed;						// used hash slots (including removed)
+	QVector<quint32> m_useCount;		// list of key use counts
 };
 
 
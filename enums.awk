@@ -38,11 +38,90 @@
 #        to to the end of this name).  If the string starts with "BUG", the
 #        string value is is a developmental TokenStatus value (the "BUG_"
 #        string will be prefixed to the name).
+#
+#  Note: The run handler list (autohandlers.h) contains a RunHandler(xxx_Code)
+#        line for each code, the runner must have a handler for each code
+#        listed (a code without a handler is a compiler error).
+#
+#  Note: The code attribute arrays (autotable.h) are generated from the token
+#        type, flags, precedence, data type and expression information fields
+#        of each table entry (the first, sixth, seventh, eighth and ninth
+#        fields, omitted fields are zero), the operand count is obtained from
+#        the "Operands(xxx)" of the expression information, which is counted
+#        from the "xxx_OperandArray" (all must precede the table entries), the
+#        arrays are checked against the table entries by the table check
+#
+#  Note: The resolved code array (also in autotable.h) holds the code for each
+#        code, operand and data type (the code or the associated code with
+#        an operand of the data type), which is resolved from the operand
+#        data types of the "xxx_OperandArray", the associated codes of the
+#        "xxx_AssocCode" and the "AssocCode(xxx)" or "AssocCode2(xxx, n)" of
+#        the expression information, the data types are obtained from the
+#        DataType enumeration in the ibcp.h source file, the array is checked
+#        against searching the associated codes by the table check
+
+# function to remove leading and trailing spaces from a string
+function trim(string)
+{
+	gsub(/^[ \t]+|[ \t]+$/, "", string)
+	return string
+}
+
+# function to remove the strings and comment from a line of table.cpp
+function strip(line)
+{
+	gsub(/"([^"\\]|\\.)*"/, "\"\"", line)
+	sub(/\/\/.*/, "", line)
+	return line
+}
+
+# function to resolve the code for an operand of a code with a data type
+# (the same search as the table check, returns Invalid_Code if none)
+function resolve(code, operand, type,    info, info2, i, end, assoc)
+{
+	info = attr_info[code]
+	if (!(info in info_count) || operand >= info_count[info])
+	{
+		return "Invalid_Code"  # code does not have the operand
+	}
+	if (operand_type[info_array[info], operand] == type)
+	{
+		return c[code]
+	}
+	# if second index -1, then no associated codes to search
+	i = info_second[info]
+	if (i < 0)
+	{
+		return "Invalid_Code"
+	}
+	end = assoc_count[info_assoc[info]]
+	if (operand == 0 && i != 0)  # first operand?
+	{
+		end = i
+		i = 0
+	}
+	for (; i < end; i++)
+	{
+		assoc = assoc_code[info_assoc[info], i]
+		info2 = attr_info[code_index[assoc]]
+		if (info2 in info_count && operand < info_count[info2] \
+			&& operand_type[info_array[info2], operand] == type)
+		{
+			return assoc
+		}
+	}
+	return "Invalid_Code"  # did not find an associated code for data type
+}
 
 BEGIN {
 	n = 0
 	code_enum = 0
 	dups = 0
+	entry = 0
+	array = ""
+	assoc = ""
+	info = ""
+	max_operands = 0
 
 	# get source path from optional first argument (2011-06-12)
 	if (ARGC >= 2)
@@ -55,16 +134,179 @@ BEGIN {
 	}
 	table_source = path "table.cpp"
 	token_source = path "token.cpp"
+	ibcp_source = path "ibcp.h"
+
+	# get the data types (in enumeration order) from the data type enumeration
+	ntypes = 0
+	data_type_enum = 0
+	while ((getline line < ibcp_source) > 0)
+	{
+		if (line ~ /^enum DataType/)
+		{
+			data_type_enum = 1
+		}
+		else if (data_type_enum == 1 && line ~ /};/)
+		{
+			data_type_enum = 0
+		}
+		else if (data_type_enum == 1 && line !~ /=/ \
+			&& match(line, /^[ \t]*[A-Za-z]+_DataType,/))
+		{
+			data_type[ntypes++] = trim(substr(line, 1, RLENGTH - 1))
+		}
+	}
 
 	while ((getline line < table_source) > 0)
 	{
 		if (code_enum == 0)
 		{
-			if (line ~ /static TableEntry tableEntries/)
+			if (line ~ /static const TableEntry tableEntries/)
 			{
 				# found start of table entries
 				code_enum = 1
 			}
+			else if (array != "" || line ~ /_OperandArray\[\] *=/)
+			{
+				# count the data types of an operand data type array
+				if (array == "")
+				{
+					array = line
+					sub(/.*const DataType[ \t]+/, "", array)
+					sub(/_OperandArray.*/, "", array)
+					operands[array] = 0
+					line = substr(line, index(line, "=") + 1)
+				}
+				while (match(line, /[A-Za-z]+_DataType/))
+				{
+					operand_type[array, operands[array]++] \
+						= substr(line, RSTART, RLENGTH)
+					line = substr(line, RSTART + RLENGTH)
+				}
+				if (operands[array] > max_operands)
+				{
+					max_operands = operands[array]
+				}
+				if (line ~ /};/)
+				{
+					array = ""
+				}
+			}
+			else if (assoc != "" || line ~ /_AssocCode\[\][ \t]*=/)
+			{
+				# get the codes of an associated code array
+				if (assoc == "")
+				{
+					assoc = line
+					sub(/.*const Code[ \t]+/, "", assoc)
+					sub(/_AssocCode.*/, "", assoc)
+					assoc_count[assoc] = 0
+					line = substr(line, index(line, "=") + 1)
+				}
+				line = strip(line)
+				while (match(line, /[A-Za-z0-9]+_Code/))
+				{
+					assoc_code[assoc, assoc_count[assoc]++] \
+						= substr(line, RSTART, RLENGTH)
+					line = substr(line, RSTART + RLENGTH)
+				}
+				if (line ~ /};/)
+				{
+					assoc = ""
+				}
+			}
+			else if (info != "" || line ~ /const ExprInfo .*_ExprInfo *=/)
+			{
+				# get the operand count of an expression information
+				if (info == "")
+				{
+					info = line
+					sub(/.*const ExprInfo[ \t]+/, "", info)
+					sub(/[ \t]*=.*/, "", info)
+					info_text = ""
+					line = substr(line, index(line, "{") + 1)
+				}
+				info_text = info_text strip(line)
+				if (line ~ /};/)
+				{
+					gsub(/[{};]/, "", info_text)
+					nf = split(info_text, field, ",")
+					for (i = nf + 1; i <= 6; i++)
+					{
+						field[i] = ""
+					}
+					count = trim(field[2])
+					if (count ~ /^Operands\(/)
+					{
+						# (macro is the count and array fields)
+						sub(/^Operands\([ \t]*/, "", count)
+						sub(/[ \t]*\)$/, "", count)
+						info_array["&" info] = count
+						count = operands[count]
+						i = 4
+					}
+					else
+					{
+						i = 5
+					}
+					info_count["&" info] = count
+					# get the associated codes (macro is the count, second
+					# index and array fields)
+					info_second["&" info] = 0
+					field[i] = trim(field[i])
+					if (field[i] ~ /^AssocCode2?\(/)
+					{
+						name = field[i]
+						sub(/^AssocCode2?\([ \t]*/, "", name)
+						sub(/[ \t]*\)$/, "", name)
+						info_assoc["&" info] = name
+						if (field[i] ~ /^AssocCode2\(/)
+						{
+							sub(/\)/, "", field[i + 1])
+							info_second["&" info] = trim(field[i + 1]) + 0
+						}
+					}
+					info = ""
+				}
+			}
+		}
+		else if (entry == 1)
+		{
+			if (line ~ /^[ \t]*},?[ \t\r]*$/)
+			{
+				# found end of table entry, get its attributes
+				nf = split(entry_text, field, ",")
+				for (i = nf + 1; i <= 9; i++)
+				{
+					field[i] = ""
+				}
+				for (i = 1; i <= 9; i++)
+				{
+					field[i] = trim(field[i])
+				}
+				attr_type[n - 1] = field[1]
+				attr_flags[n - 1] = field[6] == "" ? "Null_Flag" : field[6]
+				attr_prec[n - 1] = field[7] == "" ? "0" : field[7]
+				attr_data[n - 1] = field[8] == "" ? "(DataType)0" : field[8]
+				attr_info[n - 1] = field[9]
+				if (field[9] == "" || field[9] == "NULL")
+				{
+					attr_count[n - 1] = 0
+				}
+				else if (field[9] in info_count)
+				{
+					attr_count[n - 1] = info_count[field[9]]
+				}
+				else
+				{
+					print "Unknown expression information: ", field[9]
+					dups++
+				}
+				entry = 0
+			}
+			else
+			{
+				entry_text = entry_text strip(line)
+			}
 		}
 		else if (line ~ /};/)
 		{
@@ -92,7 +334,10 @@ BEGIN {
 				{
 					codes[field[3]] = 1
 				}
+				code_index[field[3]] = n
 				c[n++] = field[3]
+				entry = 1
+				entry_text = ""
 			}
 		}
 	}
@@ -183,6 +428,85 @@ BEGIN {
 		printf "\tsizeof_TokenStatus\n" > "autoenums.h"
 		printf "};\n" > "autoenums.h"
 
+		# write run handler list to 'autohandlers.h' (one entry per code in
+		# code order, used to build the dispatch table of the runner)
+		printf "// File: autohandlers.h - ibcp run handler list\n" \
+			> "autohandlers.h"
+		printf "//\n" > "autohandlers.h"
+		printf "// This file generated automatically by enums.awk\n" \
+			> "autohandlers.h"
+		printf "//\n" > "autohandlers.h"
+		printf "// ***  DO NOT EDIT  ***\n" > "autohandlers.h"
+		printf "\n" > "autohandlers.h"
+		for (i = 0; i < n; i++)
+		{
+			printf "RunHandler(%s)\n", c[i] > "autohandlers.h"
+		}
+
+		# write code attribute arrays to 'autotable.h' (one value per code in
+		# code order, the definitions of the arrays of the table class)
+		printf "// File: autotable.h - ibcp table code attribute arrays\n" \
+			> "autotable.h"
+		printf "//\n" > "autotable.h"
+		printf "// This file generated automatically by enums.awk\n" \
+			> "autotable.h"
+		printf "//\n" > "autotable.h"
+		printf "// ***  DO NOT EDIT  ***\n" > "autotable.h"
+		printf "\n" > "autotable.h"
+		printf "const TokenType Table::s_type[sizeof_Code] = {\n" \
+			> "autotable.h"
+		for (i = 0; i < n; i++)
+		{
+			printf "\t%s,\t// %s\n", attr_type[i], c[i] > "autotable.h"
+		}
+		printf "};\n\n" > "autotable.h"
+		printf "const DataType Table::s_dataType[sizeof_Code] = {\n" \
+			> "autotable.h"
+		for (i = 0; i < n; i++)
+		{
+			printf "\t%s,\t// %s\n", attr_data[i], c[i] > "autotable.h"
+		}
+		printf "};\n\n" > "autotable.h"
+		printf "const int Table::s_flags[sizeof_Code] = {\n" > "autotable.h"
+		for (i = 0; i < n; i++)
+		{
+			printf "\t%s,\t// %s\n", attr_flags[i], c[i] > "autotable.h"
+		}
+		printf "};\n\n" > "autotable.h"
+		printf "const qint8 Table::s_precedence[sizeof_Code] = {\n" \
+			> "autotable.h"
+		for (i = 0; i < n; i++)
+		{
+			printf "\t%s,\t// %s\n", attr_prec[i], c[i] > "autotable.h"
+		}
+		printf "};\n\n" > "autotable.h"
+		printf "const qint8 Table::s_operandCount[sizeof_Code] = {\n" \
+			> "autotable.h"
+		for (i = 0; i < n; i++)
+		{
+			printf "\t%s,\t// %s\n", attr_count[i], c[i] > "autotable.h"
+		}
+		printf "};\n\n" > "autotable.h"
+		printf "const Code Table::s_resolvedCode[sizeof_Code][MaxOperands]" \
+			"[sizeof_DataType] = {\n" > "autotable.h"
+		for (i = 0; i < n; i++)
+		{
+			printf "\t{\t// %s\n", c[i] > "autotable.h"
+			for (j = 0; j < max_operands; j++)
+			{
+				printf "\t\t{" > "autotable.h"
+				for (k = 0; k < ntypes; k++)
+				{
+					printf "%s%s", (k > 0 ? ", " : ""), \
+						resolve(i, j, data_type[k]) > "autotable.h"
+				}
+				printf "}%s\n", (j < max_operands - 1 ? "," : "") \
+					> "autotable.h"
+			}
+			printf "\t}%s\n", (i < n - 1 ? "," : "") > "autotable.h"
+		}
+		printf "};\n" > "autotable.h"
+
 		# write 'codes.txt'
 		for (i = 0; i < n; i++)
 		{
@@ -202,9 +526,11 @@ BEGIN {
 	else  # error found
 	{
 		print "" > "autoenums.h"
+		print "" > "autohandlers.h"
+		print "" > "autotable.h"
 		print "" > "codes.txt"
 		print ""
-		print "Duplicate found in table.cpp or token.cpp - please correct"
+		print "Error found in table.cpp or token.cpp - please correct"
 		# return failure code (2011-03-26)
 		exit 1
 	}
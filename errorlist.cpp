@@ -23,6 +23,7 @@
 //	2013-04-10	initial version
 
 #include "errorlist.h"
+#include "ibcp.h"
 
 
 // constructor function to set null error item
@@ -46,6 +47,19 @@ ErrorItem::ErrorItem(Type type, int lineNumber, int column, int length,
 
 ErrorList::ErrorList(void)
 {
+	resetChange();
+}
+
+
+// function to get an error from the list with its current line number
+ErrorItem ErrorList::at(int index) const
+{
+	ErrorItem errorItem = QList<ErrorItem>::at(index);
+	if (!m_lineAdjustment.isEmpty())
+	{
+		errorItem.adjustLineNumber(lineAdjustment(index));
+	}
+	return errorItem;
 }
 
 
@@ -96,9 +110,22 @@ int ErrorList::findIndex(int lineNumber) const
 }
 
 
+// function for appending an error to the end of the list
+//
+//   - used when building the list in line number order (nothing is moved)
+
+void ErrorList::append(const ErrorItem &value)
+{
+	foldLineAdjustments();
+	QList<ErrorItem>::append(value);
+	setChangeIndex(count() - 1, Insert_Operation);
+}
+
+
 // overloaded function for inserting an error into the list
 void ErrorList::insert(int index, const ErrorItem &value)
 {
+	foldLineAdjustments();
 	QList<ErrorItem>::insert(index, value);
 	setChangeIndex(index, Insert_Operation);
 }
@@ -107,6 +134,7 @@ void ErrorList::insert(int index, const ErrorItem &value)
 // overloaded function for removing an error from the list
 void ErrorList::removeAt(int index)
 {
+	foldLineAdjustments();
 	QList<ErrorItem>::removeAt(index);
 	setChangeIndex(index, Remove_Operation);
 }
@@ -115,24 +143,64 @@ void ErrorList::removeAt(int index)
 // overloaded function for replacing an error in the list
 void ErrorList::replace(int index, const ErrorItem &value)
 {
-	QList<ErrorItem>::replace(index, value);
+	ErrorItem errorItem = value;
+	if (!m_lineAdjustment.isEmpty())
+	{
+		// store line number relative to the adjustments
+		errorItem.adjustLineNumber(-lineAdjustment(index));
+	}
+	QList<ErrorItem>::replace(index, errorItem);
 	setChangeIndex(index, Change_Operation);
 }
 
 
-// function to increment line number of an error in the list
-void ErrorList::incrementLineNumber(int index)
+// function to adjust the line numbers of the errors starting at an index
+//
+//   - only the tree entries covering the index are updated
+//   - all errors from the index to the end of the list are changed
+
+void ErrorList::adjustLineNumbers(int index, int adjustment)
 {
-	(*this)[index].incrementLineNumber();
+	if (index >= count())
+	{
+		return;  // no errors to adjust
+	}
+	if (m_lineAdjustment.isEmpty())
+	{
+		m_lineAdjustment.fill(0, count() + 1);
+	}
+	for (int i = index + 1; i <= count(); i += i & -i)
+	{
+		m_lineAdjustment[i] += adjustment;
+	}
 	setChangeIndex(index, Change_Operation);
+	setChangeIndex(count() - 1, Change_Operation);
 }
 
 
-// function to decrement line number of an error in the list
-void ErrorList::decrementLineNumber(int index)
+// function to get the sum of the line number adjustments for an index
+int ErrorList::lineAdjustment(int index) const
 {
-	(*this)[index].decrementLineNumber();
-	setChangeIndex(index, Change_Operation);
+	int adjustment = 0;
+	for (int i = index + 1; i > 0; i -= i & -i)
+	{
+		adjustment += m_lineAdjustment.at(i);
+	}
+	return adjustment;
+}
+
+
+// function to apply the line number adjustments to the errors in the list
+void ErrorList::foldLineAdjustments(void)
+{
+	if (!m_lineAdjustment.isEmpty())
+	{
+		for (int i = 0; i < count(); i++)
+		{
+			(*this)[i].adjustLineNumber(lineAdjustment(i));
+		}
+		m_lineAdjustment.clear();
+	}
 }
 
 
@@ -162,4 +230,23 @@ void ErrorList::moveColumn(int index, int chars)
 }
 
 
+// function to return the memory of the list (in bytes, estimated)
+//
+//   - errors are too large to be held in the list, so the list holds
+//     pointers to the errors
+
+int ErrorList::memory(void) const
+{
+	int memory = sizeof(ErrorList) + count() * (sizeof(ErrorItem *)
+		+ sizeof(ErrorItem) - sizeof(QString))
+		+ m_changeList.count() * sizeof(void *)
+		+ m_lineAdjustment.capacity() * sizeof(int);
+	for (int i = 0; i < count(); i++)
+	{
+		memory += stringMemory(QList<ErrorItem>::at(i).message());
+	}
+	return memory;
+}
+
+
 // end: errorlist.cpp
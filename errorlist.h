@@ -27,6 +27,7 @@
 
 #include <QList>
 #include <QString>
+#include <QVector>
 
 
 enum Operation
@@ -62,13 +63,9 @@ public:
 	{
 		return m_lineNumber;
 	}
-	void incrementLineNumber(void)
+	void adjustLineNumber(int adjustment)
 	{
-		m_lineNumber++;
-	}
-	void decrementLineNumber(void)
-	{
-		m_lineNumber--;
+		m_lineNumber += adjustment;
 	}
 	int moveColumn(int chars)
 	{
@@ -97,18 +94,31 @@ private:
 
 
 // class for holding a list of all the errors of a program
-class ErrorList : public QList<ErrorItem>
+//
+//   - line numbers of inserted and deleted lines are not applied to each
+//     error after the line, but are added to a binary indexed tree of line
+//     number adjustments, so adjusting is O(log n) instead of O(n)
+//   - the line number of an error is its stored line number plus the sum
+//     of the adjustments up to its index (see the at() function)
+//   - adjustments are folded into the stored line numbers when an error is
+//     inserted or removed (which moves the rest of the errors anyway)
+class ErrorList : private QList<ErrorItem>
 {
 public:
 	ErrorList(void);
+	using QList<ErrorItem>::count;
+	using QList<ErrorItem>::size;
+	using QList<ErrorItem>::isEmpty;
+	ErrorItem at(int index) const;
 	int find(int lineNumber) const;
 	int findIndex(int lineNumber) const;
+	void append(const ErrorItem &value);
 	void insert(int index, const ErrorItem &value);
 	void removeAt(int index);
 	void replace(int index, const ErrorItem &value);
-	void incrementLineNumber(int index);
-	void decrementLineNumber(int index);
+	void adjustLineNumbers(int index, int adjustment);
 	void moveColumn(int index, int chars);
+	int memory(void) const;
 
 	void resetChange(void)
 	{
@@ -129,10 +139,13 @@ public:
 
 private:
 	void setChangeIndex(int index, Operation operation);
+	int lineAdjustment(int index) const;
+	void foldLineAdjustments(void);
 
 	int m_changeIndexStart;				// start index of change
 	int m_changeIndexEnd;				// end index of change
 	QList<Operation> m_changeList;		// list of changes
+	QVector<int> m_lineAdjustment;		// tree of line number adjustments
 };
 
 #endif // ERRORLIST_H
@@ -25,6 +25,8 @@
 #ifndef IBCP_H
 #define IBCP_H
 
+#include <QString>
+
 // include auto-generated enumerations
 #include "autoenums.h"
 
@@ -85,4 +87,24 @@ enum SubCode
 };
 
 
+// operand definitions for program words
+enum ProgramOperand
+{
+	ProgramShift_Operand = 16,		// shift of operand in instruction word
+	ProgramWide_Operand	= 0xFFFF	// operand is wide (is in next word)
+};
+
+
+// function to return the memory used by a string (in bytes, estimated)
+//
+//   - includes the string, the header of its data and its characters
+//     (the data of a shared string is counted for each string sharing it)
+
+inline int stringMemory(const QString &string)
+{
+	return sizeof(QString) + (string.isNull() ? 0
+		: 3 * sizeof(void *) + (string.capacity() + 1) * sizeof(QChar));
+}
+
+
 #endif  // IBCP_H
@@ -130,6 +130,36 @@ MainWindow::MainWindow(QWidget *parent) :
 	ui->programView->setModel(m_programModel);
 	ui->programView->setFont(m_editBox->font());
 
+	// setup program memory view (updated when the program has not been
+	// changed for a quarter second, the timer is restarted by each change,
+	// so a burst of changes only generates one memory report)
+	ui->memoryView->setFont(m_editBox->font());
+	m_memoryTimer = new QTimer(this);
+	m_memoryTimer->setSingleShot(true);
+	m_memoryTimer->setInterval(250);
+	connect(m_programModel, SIGNAL(modelReset()),
+		m_memoryTimer, SLOT(start()));
+	connect(m_programModel, SIGNAL(rowsInserted(QModelIndex, int, int)),
+		m_memoryTimer, SLOT(start()));
+	connect(m_programModel, SIGNAL(rowsRemoved(QModelIndex, int, int)),
+		m_memoryTimer, SLOT(start()));
+	connect(m_programModel, SIGNAL(dataChanged(QModelIndex, QModelIndex)),
+		m_memoryTimer, SLOT(start()));
+	connect(m_memoryTimer, SIGNAL(timeout()),
+		this, SLOT(programMemoryUpdate()));
+	connect(ui->programViewDockWidget, SIGNAL(visibilityChanged(bool)),
+		this, SLOT(programMemoryUpdate()));
+
+	// setup program compaction (when the program has not been changed for
+	// two seconds, the timer is restarted by each change)
+	m_compactTimer = new QTimer(this);
+	m_compactTimer->setSingleShot(true);
+	m_compactTimer->setInterval(2000);
+	connect(m_editBox, SIGNAL(linesChanged(int, int, int, QStringList)),
+		m_compactTimer, SLOT(start()));
+	connect(m_compactTimer, SIGNAL(timeout()),
+		m_programModel, SLOT(compact()));
+
 	//=================
 	//  SETUP PROGRAM
 	//=================
@@ -216,6 +246,19 @@ void MainWindow::statusBarUpdate(void)
 }
 
 
+// function to update the program memory view
+//
+//   - the memory report is only generated when the view is visible
+
+void MainWindow::programMemoryUpdate(void)
+{
+	if (ui->memoryView->isVisible())
+	{
+		ui->memoryView->setPlainText(m_programModel->memoryStats());
+	}
+}
+
+
 // function called when new program has been requested
 //
 //   - if it is ok to continue, the current program is cleared
@@ -463,10 +506,21 @@ void MainWindow::programOpen(const QString programPath)
 }
 
 
+// function to return the file name of the program image of a program
+static QString imageFileName(const QString &programPath)
+{
+	return programPath + ".ibi";
+}
+
+
 // function to load a program into memory
 //
-//   - for now just reads a text file and puts the text in the edit box
-//   - eventually it will need to be parsed, translated, encoded and stored
+//   - if the program has a program image that is valid and was saved from
+//     the same text as the program (see ProgramModel::saveImage), the
+//     program is loaded from the image and the edit box is set to the text
+//     of the program without updating the program again
+//   - otherwise the text of the program is put into the edit box, which
+//     gets parsed, translated, encoded and stored
 
 bool MainWindow::programLoad(const QString &programPath)
 {
@@ -478,8 +532,22 @@ bool MainWindow::programLoad(const QString &programPath)
 		return false;
 	}
 	QTextStream input(&file);
+	QString text = input.readAll();
 
-	m_editBox->setPlainText(input.readAll());
+	QString imagePath = imageFileName(programPath);
+	if (QFile::exists(imagePath)
+		&& m_programModel->loadImage(imagePath, text))
+	{
+		disconnect(m_editBox, SIGNAL(linesChanged(int, int, int, QStringList)),
+			m_programModel, SLOT(update(int, int, int, QStringList)));
+		m_editBox->setPlainText(text);
+		connect(m_editBox, SIGNAL(linesChanged(int, int, int, QStringList)),
+			m_programModel, SLOT(update(int, int, int, QStringList)));
+	}
+	else  // no program image or image is not valid
+	{
+		m_editBox->setPlainText(text);
+	}
 	m_editBox->resetModified();
 	// reset modified flag in case file loaded is empty and document wasn't
 	setWindowModified(false);
@@ -499,6 +567,8 @@ bool MainWindow::programLoad(const QString &programPath)
 //   - eventually this made be sufficient as the edit box will contain the
 //     text representation of the stored program, but may also need to
 //     collect the text from other edit boxes and/or subroutine/functions
+//   - a program image is also saved for loading the program quickly (if the
+//     image can't be saved, any old image is removed so it isn't loaded)
 
 bool MainWindow::programSave(const QString &programPath)
 {
@@ -512,10 +582,21 @@ bool MainWindow::programSave(const QString &programPath)
 		QMessageBox::warning(this, tr("IBCP"), tr("Failed to save file."));
 		return false;
 	}
+	QString text = m_editBox->toPlainText();
 	QTextStream output(&file);
-	output << m_editBox->toPlainText();
+	output << text;
+	output.flush();
+	file.close();
 	m_editBox->resetModified();
 
+	// (make sure program has the same lines as edit box before saving image)
+	QString imagePath = imageFileName(programPath);
+	if (m_programModel->rowCount() != m_editBox->blockCount()
+		|| !m_programModel->saveImage(imagePath, text))
+	{
+		QFile::remove(imagePath);
+	}
+
 	setCurProgram(programPath);
 	statusBar()->showMessage(tr("Program saved"), 2000);
 	return true;
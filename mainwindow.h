@@ -35,6 +35,8 @@ namespace Ui {
 class MainWindow;
 }
 
+class QTimer;
+
 class ProgramModel;
 class CommandLine;
 class RecentFiles;
@@ -60,6 +62,7 @@ protected:
 
 private slots:
 	void statusBarUpdate(void);
+	void programMemoryUpdate(void);
 	void on_actionNew_triggered(void);
 	void on_actionOpen_triggered(void);
 	void on_actionClearRecent_triggered(void);
@@ -102,6 +105,8 @@ private:
 	QString m_curDirectory;
 	ProgramModel *m_programModel;
 	ProgramLineDelegate *m_programLineDelegate;
+	QTimer *m_compactTimer;
+	QTimer *m_memoryTimer;
 	bool m_statusReady;
 	QLabel *m_statusPositionLabel;
 	QLabel *m_statusMessageLabel;
@@ -0,0 +1,242 @@
+// vim:ts=4:sw=4:
+//
+//	Interactive BASIC Compiler Project
+//	File: programimage.cpp - program image classes source file
+//	Copyright (C) 2013  Thunder422
+//
+//	This program is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	This program is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU General Public License for more details.
+//
+//	For a copy of the GNU General Public License,
+//	see <http://www.gnu.org/licenses/>.
+//
+//
+//	Change History:
+//
+//	2013-10-19	initial version
+
+#include <QIODevice>
+
+#include "programimage.h"
+
+
+// length written for a null string (to distinguish from an empty string)
+const quint32 NullStringLength = 0xffffffff;
+
+// function to return size padded to the next 32-bit word
+static qint64 paddedSize(qint64 size)
+{
+	return (size + 3) & ~3;
+}
+
+
+// function to calculate the checksum of data (continuing from a checksum)
+quint32 imageChecksum(const void *data, qint64 size, quint32 checksum)
+{
+	const uchar *bytes = (const uchar *)data;
+	for (qint64 i = 0; i < size; i++)
+	{
+		checksum ^= bytes[i];
+		checksum *= 16777619u;
+	}
+	return checksum;
+}
+
+
+//=================================
+//  PROGRAM IMAGE WRITER FUNCTIONS
+//=================================
+
+ImageWriter::ImageWriter(QIODevice *device) :
+	m_device(device),
+	m_error(false),
+	m_checksum(imageChecksum(NULL, 0))
+{
+
+}
+
+
+// function to write a 32-bit value
+void ImageWriter::writeInt(quint32 value)
+{
+	write(&value, sizeof(value));
+}
+
+
+// function to write a double value
+void ImageWriter::writeDouble(double value)
+{
+	write(&value, sizeof(value));
+}
+
+
+// function to write a string (its length followed by its characters)
+void ImageWriter::writeString(const QString &string)
+{
+	if (string.isNull())
+	{
+		writeInt(NullStringLength);
+	}
+	else
+	{
+		writeInt(string.length());
+		writeData(string.unicode(), string.length() * sizeof(QChar));
+	}
+}
+
+
+// function to write data padded to the next 32-bit word
+void ImageWriter::writeData(const void *data, int size)
+{
+	static const char padding[4] = {0, 0, 0, 0};
+
+	write(data, size);
+	write(padding, paddedSize(size) - size);
+}
+
+
+// function to write the checksum of the data written (the last word)
+void ImageWriter::writeChecksum(void)
+{
+	quint32 checksum = m_checksum;
+	write(&checksum, sizeof(checksum));
+}
+
+
+// function to write data to the device (unless an error already occurred)
+void ImageWriter::write(const void *data, int size)
+{
+	if (!m_error && size > 0
+		&& m_device->write((const char *)data, size) != size)
+	{
+		m_error = true;
+	}
+	m_checksum = imageChecksum(data, size, m_checksum);
+}
+
+
+//=================================
+//  PROGRAM IMAGE READER FUNCTIONS
+//=================================
+
+ImageReader::ImageReader(const uchar *data, qint64 size) :
+	m_data(data),
+	m_end(data + size),
+	m_error(false)
+{
+
+}
+
+
+// function to verify the checksum at the end of the image
+//
+//   - the checksum is removed from the image so the end of the image is
+//     the end of the data read
+
+bool ImageReader::verifyChecksum(void)
+{
+	quint32 checksum;
+	if (m_end - m_data < (qint64)sizeof(checksum))
+	{
+		return false;
+	}
+	m_end -= sizeof(checksum);
+	memcpy(&checksum, m_end, sizeof(checksum));
+	return checksum == imageChecksum(m_data, m_end - m_data);
+}
+
+
+// function to read a 32-bit value
+quint32 ImageReader::readInt(void)
+{
+	quint32 value = 0;
+	const uchar *data = read(sizeof(value));
+	if (data != NULL)
+	{
+		memcpy(&value, data, sizeof(value));
+	}
+	return value;
+}
+
+
+// function to read a count of items of a size
+//
+//   - sets an error if the items can't fit in the rest of the image
+
+int ImageReader::readCount(int itemSize)
+{
+	quint32 count = readInt();
+	if (count > (quint32)((m_end - m_data) / qMax(itemSize, 1)))
+	{
+		m_error = true;
+		m_data = m_end;
+		count = 0;
+	}
+	return count;
+}
+
+
+// function to read a double value
+double ImageReader::readDouble(void)
+{
+	double value = 0.0;
+	const uchar *data = read(sizeof(value));
+	if (data != NULL)
+	{
+		memcpy(&value, data, sizeof(value));
+	}
+	return value;
+}
+
+
+// function to read a string
+QString ImageReader::readString(void)
+{
+	quint32 length = readInt();
+	if (length == NullStringLength)
+	{
+		return QString();
+	}
+	const uchar *data = read(paddedSize((qint64)length * sizeof(QChar)));
+	if (data == NULL)
+	{
+		return QString("");  // image is in error
+	}
+	return QString((const QChar *)data, length);
+}
+
+
+// function to read data padded to the next 32-bit word
+//
+//   - returns a pointer into the image (the data is not copied)
+
+const void *ImageReader::readData(int size)
+{
+	const uchar *data = read(paddedSize(size));
+	return size > 0 ? data : NULL;
+}
+
+
+// function to advance past data checking for the end of the image
+const uchar *ImageReader::read(qint64 size)
+{
+	if (m_error || size > m_end - m_data)
+	{
+		m_error = true;
+		m_data = m_end;
+		return NULL;
+	}
+	const uchar *data = m_data;
+	m_data += size;
+	return data;
+}
+
+
+// end: programimage.cpp
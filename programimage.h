@@ -0,0 +1,114 @@
+// vim:ts=4:sw=4:
+//
+//	Interactive BASIC Compiler Project
+//	File: programimage.h - program image classes header file
+//	Copyright (C) 2013  Thunder422
+//
+//	This program is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	This program is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU General Public License for more details.
+//
+//	For a copy of the GNU General Public License,
+//	see <http://www.gnu.org/licenses/>.
+//
+//
+//	Change History:
+//
+//	2013-10-19	initial version
+
+#ifndef PROGRAMIMAGE_H
+#define PROGRAMIMAGE_H
+
+#include <QString>
+
+class QIODevice;
+
+
+// function to calculate the checksum of data (FNV-1a hash)
+quint32 imageChecksum(const void *data, qint64 size,
+	quint32 checksum = 2166136261u);
+
+
+// program image definitions
+enum {
+	ProgramImageMagic = 0x50434249,		// "IBCP" (also detects byte order)
+	ProgramImageVersion = 3				// version of program image layout
+	// the version must be incremented when the layout of the image changes
+	// (changes to the table codes are detected by the table signature)
+};
+
+
+// class for writing a program image to a device
+//
+//   - values are written as 32-bit words in the native byte order
+//   - strings and data are padded to the next 32-bit word
+//   - a checksum of the data written is kept, which is written as the
+//     last word of the image so that a corrupted image can be detected
+
+class ImageWriter
+{
+public:
+	explicit ImageWriter(QIODevice *device);
+
+	void writeInt(quint32 value);
+	void writeDouble(double value);
+	void writeString(const QString &string);
+	void writeData(const void *data, int size);
+	void writeChecksum(void);
+	bool hasError(void) const
+	{
+		return m_error;
+	}
+
+private:
+	void write(const void *data, int size);
+
+	QIODevice *m_device;				// device image is written to
+	bool m_error;						// write error occurred flag
+	quint32 m_checksum;					// checksum of data written
+};
+
+
+// class for reading a program image from memory (a mapped image file)
+//
+//   - every read is checked against the end of the image, after a read
+//     past the end, the reader is in error and only returns zero values
+//   - counts are checked against the size of the rest of the image so
+//     that an invalid image can't cause a large allocation
+
+class ImageReader
+{
+public:
+	ImageReader(const uchar *data, qint64 size);
+
+	bool verifyChecksum(void);
+	quint32 readInt(void);
+	int readCount(int itemSize);
+	double readDouble(void);
+	QString readString(void);
+	const void *readData(int size);
+	bool hasError(void) const
+	{
+		return m_error;
+	}
+	bool atEnd(void) const
+	{
+		return m_data == m_end;
+	}
+
+private:
+	const uchar *read(qint64 size);
+
+	const uchar *m_data;				// pointer to next data of image
+	const uchar *m_end;					// pointer to end of image
+	bool m_error;						// read past end of image flag
+};
+
+
+#endif  // PROGRAMIMAGE_H
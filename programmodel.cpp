@@ -22,125 +22,1131 @@
 //
 //	2013-03-15	initial version
 
+#include <QFile>
+
+#include "programimage.h"
 #include "programmodel.h"
+#include "recreator.h"
 #include "rpnlist.h"
 #include "table.h"
 #include "translator.h"
 
 
-////////////////////////////////////////////////////////////////////////////////
-//                                                                            //
-//                           PROGRAM WORD FUNCTIONS                           //
-//                                                                            //
-////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+//                           PROGRAM WORD FUNCTIONS                           //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+
+// function to return the debug text for an instruction word
+QString ProgramWord::instructionDebugText(void) const
+{
+	Table &table = Table::instance();
+	QString string;
+
+	Code code = instructionCode();
+	string += table.debugName(code);
+
+	if (instructionHasSubCode(ProgramMask_SubCode))
+	{
+		string += '\'';
+		if (instructionHasSubCode(Paren_SubCode))
+		{
+			string += ')';
+		}
+		if (instructionHasSubCode(Option_SubCode))
+		{
+			QString option = table.optionName(code);
+			string += option.isEmpty() ? "BUG" : option;
+		}
+		if (instructionHasSubCode(Colon_SubCode))
+		{
+			string += ":";
+		}
+		string += '\'';
+	}
+	return string;
+}
+
+
+// function to return the debug text for the operand of an instruction word
+QString ProgramWord::operandDebugText(QString text) const
+{
+	return QString("|%2:%3|").arg(operand()).arg(text);
+}
+
+
+// function to append an instruction to a program line
+//
+//   - a wide operand is appended in an additional word
+
+void ProgramLine::appendInstruction(Code code, unsigned subCode,
+	quint32 operand)
+{
+	ProgramWord word;
+	word.setInstruction(code, subCode, operand);
+	append(word);
+	if (word.hasWideOperand())
+	{
+		word.setWideOperand(operand);
+		append(word);
+	}
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+//                           PROGRAM CODE FUNCTIONS                           //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+
+// function to return a contiguous view of the program code
+//
+//   - moves the gap to the end of the code
+
+const ProgramWord *ProgramCode::data(void)
+{
+	moveGap(size());
+	return m_words.constData();
+}
+
+
+// function to return a contiguous view of the program code for changing
+// the operands of the code in place (see ProgramWord::setOperand)
+//
+//   - moves the gap to the end of the code
+
+ProgramWord *ProgramCode::changeData(void)
+{
+	moveGap(size());
+	return m_words.data();
+}
+
+
+// function to replace the code with the words of a program
+//
+//   - the gap is left at the end of the code
+
+void ProgramCode::load(const ProgramWord *words, int size)
+{
+	m_words.resize(size);
+	memcpy(m_words.data(), words, size * sizeof(ProgramWord));
+	m_gapBegin = m_gapEnd = size;
+}
+
+
+// function to reserve space for a size of words appended to the code
+//
+//   - the gap is moved to the end of the code, where words are appended
+
+void ProgramCode::reserve(int size)
+{
+	moveGap(this->size());
+	reserveGap(size);
+}
+
+
+// function to append an instruction (and its operand) to the code
+
+void ProgramCode::appendInstruction(Code code, unsigned subCode,
+	quint32 operand)
+{
+	ProgramWord word;
+	word.setInstruction(code, subCode, operand);
+	int count = word.hasWideOperand() ? 2 : 1;
+	reserve(count);
+	m_words[m_gapBegin++] = word;
+	if (count > 1)
+	{
+		m_words[m_gapBegin++].setWideOperand(operand);
+	}
+}
+
+
+// function to insert a line into the code at an offset
+
+void ProgramCode::insertLine(int i, const ProgramLine &line)
+{
+	if (line.size() > 0)
+	{
+		moveGap(i);
+		reserveGap(line.size());
+		memcpy(m_words.data() + m_gapBegin, line.constData(),
+			line.size() * sizeof(ProgramWord));
+		m_gapBegin += line.size();
+	}
+}
+
+
+// function to remove a line of a size from the code at an offset
+
+void ProgramCode::removeLine(int i, int n)
+{
+	if (n > 0)  // something to remove?
+	{
+		moveGap(i);
+		m_gapEnd += n;  // line words become part of the gap
+	}
+}
+
+
+// function to replace a line of a size at an offset with a new line
+
+void ProgramCode::replaceLine(int i, int n, const ProgramLine &line)
+{
+	removeLine(i, n);
+	insertLine(i, line);
+}
+
+
+// function to move the gap to an offset
+//
+//   - only the words between the gap and the offset are moved
+
+void ProgramCode::moveGap(int i)
+{
+	ProgramWord *words = m_words.data();
+	if (i < m_gapBegin)  // move words before gap to after gap
+	{
+		int count = m_gapBegin - i;
+		m_gapBegin -= count;
+		m_gapEnd -= count;
+		memmove(words + m_gapEnd, words + m_gapBegin,
+			count * sizeof(ProgramWord));
+	}
+	else if (i > m_gapBegin)  // move words after gap to before gap
+	{
+		int count = i - m_gapBegin;
+		memmove(words + m_gapBegin, words + m_gapEnd,
+			count * sizeof(ProgramWord));
+		m_gapBegin += count;
+		m_gapEnd += count;
+	}
+}
+
+
+// function to make sure the gap is at least a size
+//
+//   - the words are at least doubled when the gap needs to be enlarged so
+//     that the number of enlargements stays small as the program grows
+
+void ProgramCode::reserveGap(int n)
+{
+	int gapSize = m_gapEnd - m_gapBegin;
+	if (gapSize < n)
+	{
+		int oldSize = m_words.size();
+		int newSize = qMax(2 * oldSize, oldSize - gapSize + n);
+		int afterSize = oldSize - m_gapEnd;
+
+		m_words.resize(newSize);
+		ProgramWord *words = m_words.data();
+		memmove(words + newSize - afterSize, words + m_gapEnd,
+			afterSize * sizeof(ProgramWord));
+		m_gapEnd = newSize - afterSize;
+	}
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+//                         LINE INFO LIST FUNCTIONS                           //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+
+// function to return the offset of a line in the program code
+//
+//   - returns the size of the program code for the index after the last line
+
+int ProgramModel::LineInfoList::offset(int i) const
+{
+	int offset = 0;
+	int node = m_root;
+	while (node != -1)
+	{
+		const Node &current = m_nodes.at(node);
+		int leftCount = countOf(current.left);
+		if (i <= leftCount)
+		{
+			node = current.left;
+		}
+		else  // line is after this node
+		{
+			offset += codeSizeOf(current.left) + current.lineInfo.size;
+			i -= leftCount + 1;
+			node = current.right;
+		}
+	}
+	return offset;
+}
+
+
+// function to return the memory of the list (in bytes, estimated)
+//
+//   - includes freed nodes (which are kept for reuse)
+//   - the rpn lists of the lines are not included
+
+int ProgramModel::LineInfoList::memory(void) const
+{
+	int memory = sizeof(LineInfoList) + m_nodes.capacity() * sizeof(Node)
+		+ m_freeStack.capacity() * sizeof(int);
+	for (int i = 0; i < m_nodes.count(); i++)
+	{
+		memory += stringMemory(m_nodes.at(i).lineInfo.errorText)
+			- sizeof(QString);
+	}
+	return memory;
+}
+
+
+// function to load the information of all the lines of a program
+//
+//   - the tree is built from the nodes in line order by keeping the nodes
+//     of its right spine on a stack, a new node takes the nodes on the
+//     stack with a lower priority as its left sub-tree and is pushed
+//   - each node is popped once, when its sub-tree is complete, so its line
+//     count and code size are updated when it is popped
+
+void ProgramModel::LineInfoList::load(const QVector<LineInfo> &lineInfoList)
+{
+	m_nodes.clear();
+	m_nodes.reserve(lineInfoList.count());
+	m_freeStack.clear();
+
+	QStack<int> spine;
+	for (int i = 0; i < lineInfoList.count(); i++)
+	{
+		int node = newNode(lineInfoList.at(i));
+		int left = -1;
+		while (!spine.isEmpty()
+			&& m_nodes.at(spine.top()).priority < m_nodes.at(node).priority)
+		{
+			left = spine.pop();
+			update(left);
+		}
+		m_nodes[node].left = left;
+		if (!spine.isEmpty())
+		{
+			m_nodes[spine.top()].right = node;
+		}
+		spine.push(node);
+	}
+	m_root = -1;
+	while (!spine.isEmpty())
+	{
+		m_root = spine.pop();
+		update(m_root);
+	}
+}
+
+
+// function to replace the size of a line
+
+void ProgramModel::LineInfoList::replace(int i, int size)
+{
+	replace(m_root, i, size);
+}
+
+
+// function to insert the information of a new line at a line index
+
+void ProgramModel::LineInfoList::insert(int i, const LineInfo &lineInfo)
+{
+	int node = newNode(lineInfo);
+	int left;
+	int right;
+	split(m_root, i, left, right);
+	m_root = merge(merge(left, node), right);
+}
+
+
+// function to remove the information of a line at a line index
+
+void ProgramModel::LineInfoList::removeAt(int i)
+{
+	int left;
+	int node;
+	int right;
+	split(m_root, i, left, right);
+	split(right, 1, node, right);
+	m_freeStack.push(node);
+	m_root = merge(left, right);
+}
+
+
+// function to find the node of a line index
+
+int ProgramModel::LineInfoList::find(int i) const
+{
+	int node = m_root;
+	forever
+	{
+		const Node &current = m_nodes.at(node);
+		int leftCount = countOf(current.left);
+		if (i == leftCount)
+		{
+			return node;
+		}
+		if (i < leftCount)
+		{
+			node = current.left;
+		}
+		else  // line is after this node
+		{
+			i -= leftCount + 1;
+			node = current.right;
+		}
+	}
+}
+
+
+// function to update the line count and code size of a node's sub-tree
+
+void ProgramModel::LineInfoList::update(int node)
+{
+	Node &current = m_nodes[node];
+	current.count = countOf(current.left) + 1 + countOf(current.right);
+	current.codeSize = codeSizeOf(current.left) + current.lineInfo.size
+		+ codeSizeOf(current.right);
+}
+
+
+// function to replace the size of a line in the sub-tree of a node
+
+void ProgramModel::LineInfoList::replace(int node, int i, int size)
+{
+	int leftCount = countOf(m_nodes.at(node).left);
+	if (i < leftCount)
+	{
+		replace(m_nodes.at(node).left, i, size);
+	}
+	else if (i > leftCount)
+	{
+		replace(m_nodes.at(node).right, i - leftCount - 1, size);
+	}
+	else  // line of this node
+	{
+		m_nodes[node].lineInfo.size = size;
+	}
+	update(node);
+}
+
+
+// function to split the sub-tree of a node into two sub-trees
+//
+//   - the left sub-tree gets the lines before the line index
+
+void ProgramModel::LineInfoList::split(int node, int i, int &left, int &right)
+{
+	if (node == -1)
+	{
+		left = right = -1;
+		return;
+	}
+	int leftCount = countOf(m_nodes.at(node).left);
+	if (i <= leftCount)
+	{
+		split(m_nodes.at(node).left, i, left, m_nodes[node].left);
+		right = node;
+	}
+	else  // split point is in the right sub-tree
+	{
+		split(m_nodes.at(node).right, i - leftCount - 1, m_nodes[node].right,
+			right);
+		left = node;
+	}
+	update(node);
+}
+
+
+// function to merge two sub-trees (all lines of left are before right)
+
+int ProgramModel::LineInfoList::merge(int left, int right)
+{
+	if (left == -1)
+	{
+		return right;
+	}
+	if (right == -1)
+	{
+		return left;
+	}
+	if (m_nodes.at(left).priority > m_nodes.at(right).priority)
+	{
+		int node = merge(m_nodes.at(left).right, right);
+		m_nodes[left].right = node;
+		update(left);
+		return left;
+	}
+	else
+	{
+		int node = merge(left, m_nodes.at(right).left);
+		m_nodes[right].left = node;
+		update(right);
+		return right;
+	}
+}
+
+
+// function to allocate a new node for the information of a line
+
+int ProgramModel::LineInfoList::newNode(const LineInfo &lineInfo)
+{
+	int node;
+	if (m_freeStack.isEmpty())
+	{
+		node = m_nodes.size();
+		m_nodes.resize(node + 1);
+	}
+	else  // reuse a previously freed node
+	{
+		node = m_freeStack.pop();
+	}
+	Node &current = m_nodes[node];
+	current.lineInfo = lineInfo;
+	current.left = -1;
+	current.right = -1;
+	current.priority = random();
+	update(node);
+	return node;
+}
+
+
+// function to generate a random node priority (xorshift generator)
+
+unsigned ProgramModel::LineInfoList::random(void)
+{
+	m_seed ^= m_seed << 13;
+	m_seed ^= m_seed >> 17;
+	m_seed ^= m_seed << 5;
+	return m_seed;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+//                        PROGRAM UNIT MODEL FUNCTIONS                        //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+
+ProgramModel::ProgramModel(QObject *parent) :
+	QAbstractListModel(parent),
+	m_table(Table::instance()),
+	m_translator(new Translator(m_table))
+{
+	newDictionaries();
+}
+
+
+ProgramModel::~ProgramModel(void)
+{
+	delete m_translator;
+
+	deleteDictionaries();
+
+	// REMOVE need to delete all of the stored translated line lists
+	for (int i = 0; i < m_lineInfo.count(); i++)
+	{
+		delete m_lineInfo.at(i).rpnList;
+	}
+}
+
+
+QString ProgramModel::operandText(Code code, int operand) const
+{
+	OperandTextFunction operandText = m_table.operandTextFunction(code);
+	return operandText == NULL ? "--": operandText(this, operand);
+}
+
+
+// function to return the text of a program line
+//
+//   - the text is recreated from the code of the line
+//   - lines with errors have no code, so their text is kept
+
+QString ProgramModel::lineText(int lineIndex) const
+{
+	const LineInfo &lineInfo = m_lineInfo.at(lineIndex);
+	if (!lineInfo.errorText.isNull())
+	{
+		return lineInfo.errorText;
+	}
+	Recreator recreator(this);
+	return recreator.recreate(m_code.lineData(m_lineInfo.offset(lineIndex)),
+		lineInfo.size);
+}
+
+
+// function to return the text of the program (recreated lines)
+QString ProgramModel::text(void) const
+{
+	QStringList lines;
+	for (int i = 0; i < m_lineInfo.count(); i++)
+	{
+		lines.append(lineText(i));
+	}
+	return lines.join("\n");
+}
+
+
+// function to calculate the hash of the source text of a program image
+static quint32 sourceHash(const QString &source)
+{
+	return imageChecksum(source.unicode(), source.length() * sizeof(QChar));
+}
+
+
+// function to save the program to a program image file
+//
+//   - the image holds the code, line information, errors and dictionaries
+//     of the program along with the signature of the table codes and is
+//     ended with a checksum
+//   - the length and hash of the source text of the program (the text of
+//     the program file) are also held, so an image is only loaded for the
+//     same text (the time of the program file is not reliable)
+
+bool ProgramModel::saveImage(const QString &fileName, const QString &source)
+{
+	QFile file(fileName);
+	if (!file.open(QIODevice::WriteOnly))
+	{
+		return false;
+	}
+	ImageWriter writer(&file);
+
+	writer.writeInt(ProgramImageMagic);
+	writer.writeInt(ProgramImageVersion);
+	writer.writeInt(m_table.signature());
+	writer.writeInt(source.length());
+	writer.writeInt(sourceHash(source));
+
+	writer.writeInt(m_lineInfo.count());
+	for (int i = 0; i < m_lineInfo.count(); i++)
+	{
+		const LineInfo &lineInfo = m_lineInfo.at(i);
+		writer.writeInt(lineInfo.size);
+		writer.writeString(lineInfo.errorText);
+	}
+
+	writer.writeInt(m_code.size());
+	writer.writeData(m_code.data(), m_code.size() * sizeof(ProgramWord));
+
+	writer.writeInt(m_errors.count());
+	for (int i = 0; i < m_errors.count(); i++)
+	{
+		ErrorItem errorItem = m_errors.at(i);
+		writer.writeInt(errorItem.type());
+		writer.writeInt(errorItem.lineNumber());
+		writer.writeInt(errorItem.column());
+		writer.writeInt(errorItem.length());
+		writer.writeString(errorItem.message());
+	}
+
+	m_remDictionary->writeImage(writer);
+	m_constNumDictionary->writeImage(writer);
+	m_constStrDictionary->writeImage(writer);
+	m_printConstDictionary->writeImage(writer);
+	m_varDblDictionary->writeImage(writer);
+	m_varIntDictionary->writeImage(writer);
+	m_varStrDictionary->writeImage(writer);
+	writer.writeChecksum();
+
+	file.close();
+	return !writer.hasError();
+}
+
+
+// function to load a program replacing the current program
+//
+//   - all the lines are translated first so that the code size can be
+//     reserved, then the lines are encoded directly onto the end of the
+//     code in one pass (lines are not inserted one at a time)
+//   - the line information list is built in O(n) and the errors are
+//     appended in line order, so loading is linear in the program size
+//   - new dictionaries are used, so the old lines are not dereferenced
+
+void ProgramModel::load(const QStringList &lines)
+{
+	beginResetModel();
+
+	// REMOVE need to delete all of the stored translated line lists
+	for (int i = 0; i < m_lineInfo.count(); i++)
+	{
+		delete m_lineInfo.at(i).rpnList;
+	}
+	deleteDictionaries();
+	newDictionaries();
+
+	QVector<LineInfo> lineInfoList(lines.count());
+	int codeSize = 0;
+	for (int i = 0; i < lines.count(); i++)
+	{
+		RpnList *rpnList = m_translator->translate(lines.at(i));
+		lineInfoList[i].rpnList = rpnList;  // REMOVE keep rpn list
+		if (!rpnList->hasError())
+		{
+			codeSize += rpnList->codeSize();
+		}
+	}
+
+	m_code.clear();
+	m_code.reserve(codeSize);
+	ErrorList errors;
+	for (int i = 0; i < lines.count(); i++)
+	{
+		LineInfo &lineInfo = lineInfoList[i];
+		RpnList *rpnList = lineInfo.rpnList;
+		if (rpnList->hasError())
+		{
+			lineInfo.size = 0;
+			lineInfo.errorText = lines.at(i);  // keep text of line with error
+			errors.append(ErrorItem(ErrorItem::Input, i,
+				rpnList->errorColumn(), rpnList->errorLength(),
+				rpnList->errorMessage()));
+		}
+		else
+		{
+			lineInfo.size = encodeAppend(rpnList);
+		}
+	}
+	m_lineInfo.load(lineInfoList);
+	m_errors = errors;
+
+	endResetModel();
+
+	emit lineCountChanged(m_lineInfo.count());
+	emit errorListChanged(m_errors);
+}
 
 
-// function to return the debug text for an instruction word
-QString ProgramWord::instructionDebugText(void) const
+// function to take a snapshot of the program (see ProgramSnapshot)
+ProgramSnapshot ProgramModel::snapshot(void) const
 {
-	Table &table = Table::instance();
-	QString string;
+	return ProgramSnapshot(*this);
+}
 
-	Code code = instructionCode();
-	string += table.debugName(code);
 
-	if (instructionHasSubCode(ProgramMask_SubCode))
+// function to compact the dictionaries of the program
+//
+//   - the entries of each dictionary are renumbered so that they are dense
+//     (which shrinks the dictionaries and any arrays indexed by the entries
+//     at run time) and the operands of the code are renumbered to match
+//   - the dictionary of an operand is identified by the remove function of
+//     its code (only codes with a dictionary entry have a remove function)
+//   - for use when idle or before the program is run, since the program
+//     view shows the operands, the view is updated if any were renumbered
+
+void ProgramModel::compact(void)
+{
+	struct Renumber
 	{
-		string += '\'';
-		if (instructionHasSubCode(Paren_SubCode))
-		{
-			string += ')';
-		}
-		if (instructionHasSubCode(Option_SubCode))
+		RemoveFunction remove;			// remove function of codes
+		QVector<int> newIndex;			// new index of each old entry
+	} renumber[] = {
+		{remRemove, m_remDictionary->compact()},
+		{constNumRemove, m_constNumDictionary->compact()},
+		{constStrRemove, m_constStrDictionary->compact()},
+		{printConstRemove, m_printConstDictionary->compact()},
+		{varDblRemove, m_varDblDictionary->compact()},
+		{varIntRemove, m_varIntDictionary->compact()},
+		{varStrRemove, m_varStrDictionary->compact()}
+	};
+	const int count = sizeof(renumber) / sizeof(renumber[0]);
+
+	bool renumbered = false;
+	for (int j = 0; j < count; j++)
+	{
+		if (!renumber[j].newIndex.isEmpty())
 		{
-			QString option = table.optionName(code);
-			string += option.isEmpty() ? "BUG" : option;
+			renumbered = true;
 		}
-		if (instructionHasSubCode(Colon_SubCode))
+	}
+	if (renumbered)
+	{
+		ProgramWord *code = m_code.changeData();
+		for (int i = 0; i < m_code.size(); i++)
 		{
-			string += ":";
+			RemoveFunction remove
+				= m_table.removeFunction(code[i].instructionCode());
+			for (int j = 0; remove != NULL && j < count; j++)
+			{
+				if (renumber[j].remove == remove)
+				{
+					if (!renumber[j].newIndex.isEmpty())
+					{
+						code[i].setOperand(renumber[j].newIndex
+							.at(code[i].operand()));
+					}
+					break;
+				}
+			}
+			if (code[i].hasWideOperand())
+			{
+				i++;  // skip wide operand word
+			}
 		}
-		string += '\'';
 	}
-	return string;
+	if (renumbered || m_strings->isFragmented())
+	{
+		// (the keys are not moved when there is nothing to compact)
+		compactStrings();
+	}
+
+	if (renumbered && m_lineInfo.count() > 0)
+	{
+		emit dataChanged(index(0), index(m_lineInfo.count() - 1));
+	}
 }
 
 
-// function to return the debug text for an instruction word
-QString ProgramWord::operandDebugText(QString text) const
+// function to return a line of the memory report
+static QString memoryLine(const QString &name, int memory)
 {
-	return QString("|%2:%3|").arg(operand()).arg(text);
+	return QString("%1: %2\n").arg(name).arg(memory);
 }
 
 
-////////////////////////////////////////////////////////////////////////////////
-//                                                                            //
-//                        PROGRAM UNIT MODEL FUNCTIONS                        //
-//                                                                            //
-////////////////////////////////////////////////////////////////////////////////
+// function to return a line of the memory report for a dictionary
+static QString memoryLine(const QString &name, const Dictionary *dictionary,
+	int &total)
+{
+	int keyMemory = dictionary->keyMemory();
+	int hashMemory = dictionary->hashMemory();
+	int useCountMemory = dictionary->useCountMemory();
+	int infoMemory = dictionary->infoMemory();
+	int memory = keyMemory + hashMemory + useCountMemory + infoMemory;
+	total += memory;
+	return QString("%1: %2 (keys %3, hash %4, use counts %5, info %6)\n")
+		.arg(name).arg(memory).arg(keyMemory).arg(hashMemory)
+		.arg(useCountMemory).arg(infoMemory);
+}
 
 
-ProgramModel::ProgramModel(QObject *parent) :
-	QAbstractListModel(parent),
-	m_table(Table::instance()),
-	m_translator(new Translator(m_table))
-{
-	m_remDictionary = new Dictionary;
-	m_constNumDictionary = new InfoDictionary<ConstNumInfo>;
-	m_constStrDictionary = new ConstStrDictionary;
+// function to return a report of the memory used by the program
+//
+//   - the memory is in bytes and is estimated from the sizes of the
+//     containers and their items (allocation overhead is not included)
+//   - the token free pool is shared by all programs, so it is not
+//     included in the total
 
-	m_varDblDictionary = new Dictionary;
-	m_varIntDictionary = new Dictionary;
-	m_varStrDictionary = new Dictionary;
+QString ProgramModel::memoryStats(void) const
+{
+	int rpnListMemory = 0;
+	int tokenMemory = 0;
+	for (int i = 0; i < m_lineInfo.count(); i++)
+	{
+		RpnList *rpnList = m_lineInfo.at(i).rpnList;
+		if (rpnList != NULL)
+		{
+			rpnListMemory += rpnList->memory();
+			tokenMemory += rpnList->tokenMemory();
+		}
+	}
+	int total = m_code.memory() + m_lineInfo.memory() + rpnListMemory
+		+ tokenMemory + m_errors.memory() + m_strings->memory();
+
+	QString string = QString("Program Memory (%1 lines):\n")
+		.arg(m_lineInfo.count());
+	string.append(memoryLine("Code", m_code.memory()));
+	string.append(memoryLine("Line Information", m_lineInfo.memory()));
+	string.append(memoryLine("RPN Lists", rpnListMemory));
+	string.append(memoryLine("Tokens", tokenMemory));
+	string.append(memoryLine("Errors", m_errors.memory()));
+	string.append(memoryLine("Dictionary Strings", m_strings->memory()));
+	string.append(memoryLine("Remarks", m_remDictionary, total));
+	string.append(memoryLine("Number Constants", m_constNumDictionary,
+		total));
+	string.append(memoryLine("String Constants", m_constStrDictionary,
+		total));
+	string.append(memoryLine("Print Constants", m_printConstDictionary,
+		total));
+	string.append(memoryLine("Double Variables", m_varDblDictionary, total));
+	string.append(memoryLine("Integer Variables", m_varIntDictionary, total));
+	string.append(memoryLine("String Variables", m_varStrDictionary, total));
+	string.append(memoryLine("Total", total));
+	string.append(memoryLine("Token Free Pool", Token::freeMemory()));
+	return string;
 }
 
 
-ProgramModel::~ProgramModel(void)
+// function to load the program from a program image file
+//
+//   - the image file is mapped into memory and validated (including its
+//     checksum), and the code is copied from the image as is (lines are
+//     not translated and encoded)
+//   - an image with a different table signature is rejected since the
+//     codes in the image no longer match the codes of the table
+//   - an image of a different source text is rejected (see saveImage)
+//   - the operands of the code are checked against the dictionaries
+//   - the current program is not changed if the image is not valid
+
+bool ProgramModel::loadImage(const QString &fileName, const QString &source)
 {
-	delete m_translator;
+	QFile file(fileName);
+	if (!file.open(QIODevice::ReadOnly))
+	{
+		return false;
+	}
+	qint64 size = file.size();
+	uchar *data = file.map(0, size);
+	if (data == NULL)
+	{
+		return false;
+	}
 
-	delete m_remDictionary;
-	delete m_constNumDictionary;
-	delete m_constStrDictionary;
+	ImageReader reader(data, size);
+	LineInfoList lineInfoList;
+	ProgramCode code;
+	ErrorList errors;
+
+	StringArena *strings = new StringArena;
+	Dictionary *remDictionary = new Dictionary(strings, Qt::CaseSensitive);
+	ConstNumDictionary *constNumDictionary = new ConstNumDictionary(strings);
+	ConstStrDictionary *constStrDictionary = new ConstStrDictionary(strings);
+	PrintConstDictionary *printConstDictionary
+		= new PrintConstDictionary(strings);
+	Dictionary *varDblDictionary = new Dictionary(strings);
+	Dictionary *varIntDictionary = new Dictionary(strings);
+	Dictionary *varStrDictionary = new Dictionary(strings);
+
+	// (in the order of the remove functions of checkImageOperands)
+	Dictionary *const dictionaries[] = {
+		remDictionary, constNumDictionary, constStrDictionary,
+		printConstDictionary, varDblDictionary, varIntDictionary,
+		varStrDictionary
+	};
+
+	bool valid = reader.verifyChecksum()
+		&& readImage(reader, source, lineInfoList, code, errors)
+		&& remDictionary->readImage(reader)
+		&& constNumDictionary->readImage(reader)
+		&& constStrDictionary->readImage(reader)
+		&& printConstDictionary->readImage(reader)
+		&& varDblDictionary->readImage(reader)
+		&& varIntDictionary->readImage(reader)
+		&& varStrDictionary->readImage(reader)
+		&& reader.atEnd()
+		&& checkImageOperands(code, dictionaries);
+	file.unmap(data);
+
+	if (!valid)
+	{
+		delete strings;
+		delete remDictionary;
+		delete constNumDictionary;
+		delete constStrDictionary;
+		delete printConstDictionary;
+		delete varDblDictionary;
+		delete varIntDictionary;
+		delete varStrDictionary;
+		return false;
+	}
 
-	delete m_varDblDictionary;
-	delete m_varIntDictionary;
-	delete m_varStrDictionary;
+	beginResetModel();
 
 	// REMOVE need to delete all of the stored translated line lists
 	for (int i = 0; i < m_lineInfo.count(); i++)
 	{
 		delete m_lineInfo.at(i).rpnList;
 	}
+	m_lineInfo = lineInfoList;
+	m_code = code;
+	m_errors = errors;
+
+	deleteDictionaries();
+
+	m_strings = strings;
+	m_remDictionary = remDictionary;
+	m_constNumDictionary = constNumDictionary;
+	m_constStrDictionary = constStrDictionary;
+	m_printConstDictionary = printConstDictionary;
+	m_varDblDictionary = varDblDictionary;
+	m_varIntDictionary = varIntDictionary;
+	m_varStrDictionary = varStrDictionary;
+
+	endResetModel();
+
+	emit lineCountChanged(m_lineInfo.count());
+	emit errorListChanged(m_errors);
+	return true;
 }
 
 
-QString ProgramModel::operandText(Code code, int operand) const
+// function to read and validate the lines, code and errors of an image
+//
+//   - the sizes of the lines must add up to the size of the code
+//   - each line must contain valid codes with their operands
+//   - lines with errors must have no code and must have their text
+
+bool ProgramModel::readImage(ImageReader &reader, const QString &source,
+	LineInfoList &lineInfoList, ProgramCode &code, ErrorList &errors)
 {
-	OperandTextFunction operandText = m_table.operandTextFunction(code);
-	return operandText == NULL ? "--": operandText(this, operand);
+	if (reader.readInt() != ProgramImageMagic
+		|| reader.readInt() != ProgramImageVersion
+		|| reader.readInt() != m_table.signature())
+	{
+		return false;  // not an image or image from a different version
+	}
+	if (reader.readInt() != (quint32)source.length()
+		|| reader.readInt() != sourceHash(source))
+	{
+		return false;  // image of a different source text
+	}
+
+	int lineCount = reader.readCount(2 * sizeof(quint32));
+	QVector<LineInfo> lineInfo(lineCount);
+	int codeSize = 0;
+	for (int i = 0; i < lineCount; i++)
+	{
+		lineInfo[i].rpnList = NULL;
+		lineInfo[i].size = reader.readInt();
+		lineInfo[i].errorText = reader.readString();
+		if (lineInfo.at(i).size < 0 || !lineInfo.at(i).errorText.isNull()
+			&& lineInfo.at(i).size != 0)
+		{
+			return false;  // invalid size or line with error has code
+		}
+		codeSize += lineInfo.at(i).size;
+	}
+
+	int size = reader.readCount(sizeof(ProgramWord));
+	const ProgramWord *words
+		= (const ProgramWord *)reader.readData(size * sizeof(ProgramWord));
+	if (size != codeSize)
+	{
+		return false;  // lines do not match code
+	}
+	const ProgramWord *line = words;
+	for (int i = 0; i < lineCount; line += lineInfo.at(i++).size)
+	{
+		for (int j = 0; j < lineInfo.at(i).size; j++)
+		{
+			Code code = line[j].instructionCode();
+			if (code >= sizeof_Code)
+			{
+				return false;  // invalid code
+			}
+			if (line[j].hasWideOperand() && ++j == lineInfo.at(i).size)
+			{
+				return false;  // missing wide operand
+			}
+		}
+	}
+	lineInfoList.load(lineInfo);
+	code.load(words, size);
+
+	int errorCount = reader.readCount(5 * sizeof(quint32));
+	int lastLineNumber = -1;
+	for (int i = 0; i < errorCount; i++)
+	{
+		ErrorItem::Type type = (ErrorItem::Type)reader.readInt();
+		int lineNumber = reader.readInt();
+		int column = reader.readInt();
+		int length = reader.readInt();
+		QString message = reader.readString();
+		if (type == ErrorItem::None || type > ErrorItem::Code
+			|| lineNumber <= lastLineNumber || lineNumber >= lineCount
+			|| lineInfo.at(lineNumber).errorText.isNull())
+		{
+			return false;  // invalid error or error not on line with error
+		}
+		errors.append(ErrorItem(type, lineNumber, column, length, message));
+		lastLineNumber = lineNumber;
+	}
+	return !reader.hasError();
+}
+
+
+// function to check the operands of the code of an image against the
+// dictionaries read from the image
+//
+//   - the dictionary of an operand is identified by the remove function of
+//     its code (see compact), the operand must be an entry of the
+//     dictionary that is not free
+//   - the uses of each entry are counted from the code, which must match
+//     the use counts of the dictionaries (or entries would be removed
+//     while still used or never removed)
+
+bool ProgramModel::checkImageOperands(ProgramCode &code,
+	Dictionary *const *dictionaries)
+{
+	static const RemoveFunction removeFunctions[] = {
+		remRemove, constNumRemove, constStrRemove, printConstRemove,
+		varDblRemove, varIntRemove, varStrRemove
+	};
+	const int count = sizeof(removeFunctions) / sizeof(removeFunctions[0]);
+
+	QVector<quint32> useCounts[count];
+	for (int j = 0; j < count; j++)
+	{
+		useCounts[j].fill(0, dictionaries[j]->count());
+	}
+	const ProgramWord *words = code.data();
+	for (int i = 0; i < code.size(); i++)
+	{
+		RemoveFunction remove
+			= m_table.removeFunction(words[i].instructionCode());
+		for (int j = 0; remove != NULL && j < count; j++)
+		{
+			if (removeFunctions[j] == remove)
+			{
+				quint32 operand = words[i].operand();
+				if (operand >= (quint32)dictionaries[j]->count()
+					|| dictionaries[j]->useCount(operand) == 0)
+				{
+					return false;  // operand not an entry or a free entry
+				}
+				useCounts[j][operand]++;
+				break;
+			}
+		}
+		if (words[i].hasWideOperand())
+		{
+			i++;  // skip wide operand word
+		}
+	}
+	for (int j = 0; j < count; j++)
+	{
+		for (int index = 0; index < dictionaries[j]->count(); index++)
+		{
+			if (useCounts[j].at(index) != dictionaries[j]->useCount(index))
+			{
+				return false;  // use count does not match the code
+			}
+		}
+	}
+	return true;
 }
 
 
 // NOTE temporary function to return the text for a program line
+//
+//   - the offsets and indexes are of the program words, an operand is
+//     preceded by the index of the word holding it (the instruction word,
+//     or the next word for a wide operand)
+
 QString ProgramModel::debugText(int lineIndex, bool fullInfo) const
 {
 	QString string;
 
 	const LineInfo &lineInfo = m_lineInfo[lineIndex];
+	int offset = m_lineInfo.offset(lineIndex);
 	if (fullInfo)
 	{
-		string.append(QString("[%1").arg(lineInfo.offset));
+		string.append(QString("[%1").arg(offset));
 		if (lineInfo.size > 0)
 		{
-			string.append(QString("-%1").arg(lineInfo.offset + lineInfo.size
-				- 1));
+			string.append(QString("-%1").arg(offset + lineInfo.size - 1));
 		}
 		string.append("]");
 	}
 
-	const ProgramWord *line = m_code.data() + m_lineInfo.at(lineIndex).offset;
-	int count = m_lineInfo.at(lineIndex).size;
+	const ProgramWord *line = m_code.lineData(offset);
+	int count = lineInfo.size;
 	for (int i = 0; i < count; i++)
 	{
 		if (i > 0 || fullInfo)
@@ -152,15 +1158,20 @@ QString ProgramModel::debugText(int lineIndex, bool fullInfo) const
 		Code code = line[i].instructionCode();
 		if (m_table.hasFlag(code, HasOperand_Flag))
 		{
-			const QString operand = operandText(code, line[++i].operand());
-			string += QString(" %1:%2").arg(i)
-				.arg(line[i].operandDebugText(operand));
+			const QString operand = operandText(code, line[i].operand());
+			string += QString(" %1:%2").arg(line[i].hasWideOperand() ? i + 1
+				: i).arg(line[i].operandDebugText(operand));
+		}
+		if (line[i].hasWideOperand())
+		{
+			i++;  // skip wide operand word
 		}
 	}
 
-	if (fullInfo && lineInfo.errIndex != -1)
+	int errIndex;
+	if (fullInfo && (errIndex = m_errors.findIndex(lineIndex)) != -1)
 	{
-		const ErrorItem &errorItem = m_errors[lineInfo.errIndex];
+		ErrorItem errorItem = m_errors.at(errIndex);
 		string.append(QString(" ERROR %1:%2 %3").arg(errorItem.column())
 			.arg(errorItem.length()).arg(errorItem.message()));
 	}
@@ -177,6 +1188,7 @@ QString ProgramModel::dictionariesDebugText(void)
 	string.append(m_remDictionary->debugText("Remarks"));
 	string.append(m_constNumDictionary->debugText("Number Constants"));
 	string.append(m_constStrDictionary->debugText("String Constants"));
+	string.append(m_printConstDictionary->debugText("Print Constants"));
 	string.append(m_varDblDictionary->debugText("Double Variables"));
 	string.append(m_varIntDictionary->debugText("Integer Variables"));
 	string.append(m_varStrDictionary->debugText("String Variables"));
@@ -219,6 +1231,14 @@ void ProgramModel::update(int lineNumber, int linesDeleted, int linesInserted,
 	int i;
 	int oldCount = m_lineInfo.count();
 	int count = lines.count();
+	if (lineNumber == 0 && count - linesInserted + linesDeleted == oldCount
+		&& count + linesDeleted > 1)
+	{
+		// every line of the program was replaced (program loaded or cleared)
+		// (not for a change of the line of a one line program)
+		load(lines);
+		return;
+	}
 	m_errors.resetChange();
 	for (i = 0; i < count - linesInserted; i++)
 	{
@@ -254,6 +1274,12 @@ void ProgramModel::update(int lineNumber, int linesDeleted, int linesInserted,
 		endInsertRows();
 	}
 
+	if (m_strings->isFragmented())
+	{
+		// keys of lines removed or changed left too much unused space
+		compactStrings();
+	}
+
 	if (m_lineInfo.count() != oldCount)
 	{
 		// emit new line count if changed
@@ -272,7 +1298,7 @@ bool ProgramModel::updateLine(Operation operation, int lineNumber,
 	const QString &line)
 {
 	RpnList *rpnList;
-	ProgramCode lineCode;
+	ProgramLine lineCode;
 	ErrorItem errorItem;
 
 	if (operation != Remove_Operation)
@@ -291,7 +1317,11 @@ bool ProgramModel::updateLine(Operation operation, int lineNumber,
 	if (operation == Change_Operation)
 	{
 		LineInfo &lineInfo = m_lineInfo[lineNumber];
-		if (*rpnList == *lineInfo.rpnList)
+
+		// keep text of line if it has an error (even if line not changed)
+		lineInfo.errorText = errorItem.isEmpty() ? QString() : line;
+
+		if (lineInfo.rpnList != NULL && *rpnList == *lineInfo.rpnList)
 		{
 			return false;  // line not changed; nothing more to do here
 		}
@@ -306,21 +1336,25 @@ bool ProgramModel::updateLine(Operation operation, int lineNumber,
 		delete lineInfo.rpnList;
 		lineInfo.rpnList = rpnList;
 
-		updateError(lineNumber, lineInfo, errorItem, false);
+		updateError(lineNumber, errorItem, false);
 
 		// derefence old line and replace with new line
 		// (line gets deleted if new line has an error)
-		dereference(lineInfo);
-		m_code.replaceLine(lineInfo.offset, lineInfo.size, lineCode);
+		dereference(lineNumber);
+		m_code.replaceLine(m_lineInfo.offset(lineNumber), lineInfo.size,
+			lineCode);
 		m_lineInfo.replace(lineNumber, lineCode.size());
 	}
 	else if (operation == Insert_Operation)
 	{
 		LineInfo lineInfo;
 		lineInfo.rpnList = rpnList;  // REMOVE replace rpn list
-		lineInfo.errIndex = -1;
+		if (!errorItem.isEmpty())
+		{
+			lineInfo.errorText = line;  // keep text of line with error
+		}
 
-		updateError(lineNumber, lineInfo, errorItem, true);
+		updateError(lineNumber, errorItem, true);
 
 		// encode line if there was no translation error
 		if (errorItem.isEmpty())
@@ -328,19 +1362,10 @@ bool ProgramModel::updateLine(Operation operation, int lineNumber,
 			lineCode = encode(rpnList);
 		}
 
-		// find offset to insert line
-		if (lineNumber < m_lineInfo.count())
-		{
-			lineInfo.offset = m_lineInfo.at(lineNumber).offset;
-		}
-		else  // append to end
-		{
-			lineInfo.offset = m_code.size();
-		}
 		lineInfo.size = lineCode.size();  // zero if line has error
 
 		// insert line into code (nothing if line has error)
-		m_code.insertLine(lineInfo.offset, lineCode);
+		m_code.insertLine(m_lineInfo.offset(lineNumber), lineCode);
 
 		m_lineInfo.insert(lineNumber, lineInfo);
 	}
@@ -348,14 +1373,14 @@ bool ProgramModel::updateLine(Operation operation, int lineNumber,
 	{
 		LineInfo &lineInfo = m_lineInfo[lineNumber];
 
-		removeError(lineNumber, lineInfo, true);
+		removeError(lineNumber, true);
 
 		// REMOVE delete rpn list
 		delete lineInfo.rpnList;
 
 		// derefence old line and remove from code
-		dereference(lineInfo);
-		m_code.removeLine(lineInfo.offset, lineInfo.size);
+		dereference(lineNumber);
+		m_code.removeLine(m_lineInfo.offset(lineNumber), lineInfo.size);
 
 		// remove from line info list
 		m_lineInfo.removeAt(lineNumber);
@@ -365,141 +1390,263 @@ bool ProgramModel::updateLine(Operation operation, int lineNumber,
 
 
 // function to update error into list if line has an error
-void ProgramModel::updateError(int lineNumber, LineInfo &lineInfo,
-	const ErrorItem &errorItem, bool lineInserted)
+//
+//   - line numbers of the errors after an inserted line are adjusted
+//     by the error list without going through each of the errors
+
+void ProgramModel::updateError(int lineNumber, const ErrorItem &errorItem,
+	bool lineInserted)
 {
+	int errIndex;
+
 	if (!lineInserted)
 	{
 		if (errorItem.isEmpty())
 		{
-			removeError(lineNumber, lineInfo, false);
+			removeError(lineNumber, false);
 			return;  // nothing more to do
 		}
-		else if (lineInfo.errIndex != -1)  // had error?
+		else if ((errIndex = m_errors.findIndex(lineNumber)) != -1)  // had error?
 		{
 			// replace current error
-			m_errors.replace(lineInfo.errIndex, errorItem);
+			m_errors.replace(errIndex, errorItem);
 			return;  // nothing more to do
 		}
 	}
 
 	// find location in error list for line number
-	int errIndex = m_errors.find(lineNumber);
+	errIndex = m_errors.find(lineNumber);
 
 	if (!errorItem.isEmpty())
 	{
 		// insert new error into error list
-		m_errors.insert(errIndex, errorItem);
-
-		lineInfo.errIndex = errIndex++;
+		m_errors.insert(errIndex++, errorItem);
 	}
 
-	// loop thru rest of errors in list
-	for (; errIndex < m_errors.count(); errIndex++)
+	if (lineInserted)
 	{
-		if (!errorItem.isEmpty())
-		{
-			// adjust error index for inserted error
-			m_lineInfo[m_errors[errIndex].lineNumber()].errIndex++;
-		}
-		if (lineInserted)
-		{
-			// adjust error line number for inserted line
-			m_errors.incrementLineNumber(errIndex);
-		}
+		// adjust line numbers of rest of errors for inserted line
+		m_errors.adjustLineNumbers(errIndex, 1);
 	}
 }
 
 
 // function to remove an error from the list if line had an error
-void ProgramModel::removeError(int lineNumber, LineInfo &lineInfo,
-	bool lineDeleted)
+void ProgramModel::removeError(int lineNumber, bool lineDeleted)
 {
-	int errIndex;
-	bool hadError;
+	int errIndex = m_errors.findIndex(lineNumber);
 
-	if (lineInfo.errIndex != -1)
+	if (errIndex != -1)
 	{
-		errIndex = lineInfo.errIndex;
-
 		// remove error (for changed line with no error or deleted line)
 		m_errors.removeAt(errIndex);
-
-		lineInfo.errIndex = -1;
-		hadError = true;
 	}
 	else if (lineDeleted)
 	{
 		// find location in error list for line number
 		errIndex = m_errors.find(lineNumber);
-		hadError = false;
 	}
 	else  // line not deleted and did not have an error
 	{
 		return;  // nothing more to do
 	}
 
-	// loop thru rest of errors in list
-	for (; errIndex < m_errors.count(); errIndex++)
+	if (lineDeleted)
 	{
-		if (hadError)
-		{
-			// adjust error index for removed error
-			m_lineInfo[m_errors[errIndex].lineNumber()].errIndex--;
-		}
-		if (lineDeleted)
-		{
-			// adjust error line number for deleted line
-			m_errors.decrementLineNumber(errIndex);
-		}
+		// adjust line numbers of rest of errors for deleted line
+		m_errors.adjustLineNumbers(errIndex, -1);
 	}
 }
 
 
 // function to encode a translated RPN list
-ProgramCode ProgramModel::encode(RpnList *input)
+//
+//   - the code size of the list is in the old program word format (where
+//     each operand has its own word), which is the most words needed
+
+ProgramLine ProgramModel::encode(RpnList *input)
 {
-	ProgramCode programLine(input->codeSize());
+	ProgramLine programLine;
+	programLine.reserve(input->codeSize());
+
+	for (int i = 0; i < input->count(); i++)
+	{
+		Token *token = input->at(i)->token();
+		quint32 operand;
+		Code code = encodeToken(token, &operand);
+		programLine.appendInstruction(code, token->subCodes(), operand);
+	}
+	return programLine;
+}
+
+
+// function to encode a translated RPN list onto the end of the program
+// code (returns the size of the code of the list)
+//
+//   - for loading a program, where the code of all the lines is reserved
 
+int ProgramModel::encodeAppend(RpnList *input)
+{
+	int offset = m_code.size();
 	for (int i = 0; i < input->count(); i++)
 	{
 		Token *token = input->at(i)->token();
-		programLine[token->index()].setInstruction(token->code(),
-			token->subCodes());
-		if (m_table.hasFlag(token, HasOperand_Flag))
+		quint32 operand;
+		Code code = encodeToken(token, &operand);
+		m_code.appendInstruction(code, token->subCodes(), operand);
+	}
+	return m_code.size() - offset;
+}
+
+
+// function to encode the code and operand of a token
+//
+//   - small integer constants are encoded as immediate codes with the
+//     value in the operand (the constant is not put in the dictionary)
+
+Code ProgramModel::encodeToken(Token *token, quint32 *operand)
+{
+	Code code = token->code();
+	*operand = 0;
+	if ((code == Const_Code || code == ConstInt_Code)
+		&& constNumIsImmediate(token))
+	{
+		code = code == Const_Code ? ConstImm_Code : ConstIntImm_Code;
+		*operand = token->valueInt();
+	}
+	else if (m_table.hasFlag(token, HasOperand_Flag))
+	{
+		EncodeFunction encode = m_table.encodeFunction(code);
+		if (encode != NULL)
 		{
-			quint16 operand;
-			EncodeFunction encode = m_table.encodeFunction(token->code());
-			if (encode == NULL)
-			{
-				// TODO for now set set operand to zero
-				operand = 0;
-			}
-			else
-			{
-				operand = encode(this, token);
-			}
-			programLine[token->index() + 1].setOperand(operand);
+			*operand = encode(this, token);
 		}
+		// TODO for now operand of codes without encode function is zero
 	}
-	return programLine;
+	return code;
+}
+
+
+// function to allocate new empty dictionaries for the program
+//
+//   - remarks and string constants are case sensitive, number constants
+//     (for the exponent character) and variables are not
+
+void ProgramModel::newDictionaries(void)
+{
+	m_strings = new StringArena;
+
+	m_remDictionary = new Dictionary(m_strings, Qt::CaseSensitive);
+	m_constNumDictionary = new ConstNumDictionary(m_strings);
+	m_constStrDictionary = new ConstStrDictionary(m_strings);
+	m_printConstDictionary = new PrintConstDictionary(m_strings);
+
+	m_varDblDictionary = new Dictionary(m_strings);
+	m_varIntDictionary = new Dictionary(m_strings);
+	m_varStrDictionary = new Dictionary(m_strings);
+}
+
+
+// function to delete the dictionaries of the program
+void ProgramModel::deleteDictionaries(void)
+{
+	delete m_strings;
+
+	delete m_remDictionary;
+	delete m_constNumDictionary;
+	delete m_constStrDictionary;
+	delete m_printConstDictionary;
+
+	delete m_varDblDictionary;
+	delete m_varIntDictionary;
+	delete m_varStrDictionary;
+}
+
+
+// function to compact the string arena holding the keys of the dictionaries
+//
+//   - the keys of the dictionaries are moved to a new arena, which leaves
+//     out the space of removed keys (the entries of the dictionaries and
+//     so the operands of the code are not changed)
+
+void ProgramModel::compactStrings(void)
+{
+	StringArena *strings = new StringArena;
+
+	m_remDictionary->moveKeys(strings);
+	m_constNumDictionary->moveKeys(strings);
+	m_constStrDictionary->moveKeys(strings);
+	m_printConstDictionary->moveKeys(strings);
+
+	m_varDblDictionary->moveKeys(strings);
+	m_varIntDictionary->moveKeys(strings);
+	m_varStrDictionary->moveKeys(strings);
+
+	delete m_strings;
+	m_strings = strings;
 }
 
 
 // function to dereference contents of line to prepare for its removal
-void ProgramModel::dereference(const LineInfo &lineInfo)
+void ProgramModel::dereference(int lineIndex)
 {
-	ProgramWord *line = m_code.data() + lineInfo.offset;
-	for (int i = 0; i < lineInfo.size; i++)
+	const ProgramWord *line = m_code.lineData(m_lineInfo.offset(lineIndex));
+	int count = m_lineInfo.at(lineIndex).size;
+	for (int i = 0; i < count; i++)
 	{
-		Code code = line[i].instructionCode();
-		RemoveFunction remove = m_table.removeFunction(code);
+		RemoveFunction remove = m_table.removeFunction(line[i]
+			.instructionCode());
 		if (remove != NULL)
 		{
-			remove(this, line[++i].operand());
+			remove(this, line[i].operand());
+		}
+		if (line[i].hasWideOperand())
+		{
+			i++;  // skip wide operand word
 		}
 	}
 
 }
 
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+//                         PROGRAM SNAPSHOT FUNCTIONS                         //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+
+ProgramSnapshot::ProgramSnapshot(const ProgramModel &programModel) :
+	m_data(new Data(programModel))
+{
+
+}
+
+
+// function to copy the program into the data of a snapshot
+//
+//   - the copied dictionaries are set to the copy of the string arena
+
+ProgramSnapshot::Data::Data(const ProgramModel &programModel) :
+	lineInfo(programModel.m_lineInfo),
+	code(programModel.m_code),
+	strings(*programModel.m_strings),
+	remDictionary(*programModel.m_remDictionary),
+	constNumDictionary(*programModel.m_constNumDictionary),
+	constStrDictionary(*programModel.m_constStrDictionary),
+	printConstDictionary(*programModel.m_printConstDictionary),
+	varDblDictionary(*programModel.m_varDblDictionary),
+	varIntDictionary(*programModel.m_varIntDictionary),
+	varStrDictionary(*programModel.m_varStrDictionary)
+{
+	remDictionary.setStrings(&strings);
+	constNumDictionary.setStrings(&strings);
+	constStrDictionary.setStrings(&strings);
+	printConstDictionary.setStrings(&strings);
+	varDblDictionary.setStrings(&strings);
+	varIntDictionary.setStrings(&strings);
+	varStrDictionary.setStrings(&strings);
+}
+
+
 // end: programmodel.cpp
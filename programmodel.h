@@ -26,6 +26,8 @@
 #define PROGRAMMODEL_H
 
 #include <QAbstractListModel>
+#include <QSharedPointer>
+#include <QStack>
 #include <QString>
 #include <QStringList>
 #include <QVector>
@@ -35,12 +37,20 @@
 #include "errorlist.h"
 #include "basic/basic.h"
 
+class ImageReader;
+class ProgramSnapshot;
 class RpnList;
 class Table;
 class Translator;
 
 
 // class for holding and accessing a program word
+//
+//   - an instruction word holds the code and sub-codes of the instruction
+//     in its low half and the operand of the instruction in its high half
+//   - an operand too large for the high half (a wide operand) is held in
+//     the next word with the high half set to the wide operand value
+
 class ProgramWord
 {
 public:
@@ -53,103 +63,110 @@ public:
 	{
 		return (m_word & subCode) != 0;
 	}
-	void setInstruction(Code code, unsigned subCode)
+	void setInstruction(Code code, unsigned subCode, quint32 operand = 0)
 	{
-		m_word = (unsigned)code | subCode & ProgramMask_SubCode;
+		m_word = (unsigned)code | (subCode & ProgramMask_SubCode)
+			| (qMin(operand, (quint32)ProgramWide_Operand)
+			<< ProgramShift_Operand);
 	}
 	QString instructionDebugText(void) const;
 
-	// operand word access functions
-	unsigned short operand(void) const
+	// operand access functions
+	bool hasWideOperand(void) const
+	{
+		return m_word >> ProgramShift_Operand == ProgramWide_Operand;
+	}
+	quint32 operand(void) const
 	{
-		return m_word;
+		// (the word after the instruction word holds a wide operand)
+		return hasWideOperand() ? this[1].m_word
+			: m_word >> ProgramShift_Operand;
 	}
-	void setOperand(unsigned short operand)
+	void setWideOperand(quint32 operand)
 	{
 		m_word = operand;
 	}
+	void setOperand(quint32 operand)
+	{
+		// (a wide operand is kept wide, so the size of the code does not
+		// change, the operand must fit if not wide)
+		if (hasWideOperand())
+		{
+			this[1].m_word = operand;
+		}
+		else
+		{
+			m_word = (m_word & ~((quint32)ProgramWide_Operand
+				<< ProgramShift_Operand)) | (operand << ProgramShift_Operand);
+		}
+	}
 	QString operandDebugText(QString text) const;
 
 private:
-	unsigned short m_word;				// one program word
+	quint32 m_word;						// one program word
+};
+
+
+// class for holding the code of one program line
+class ProgramLine : public QVector<ProgramWord>
+{
+public:
+	ProgramLine(void): QVector<ProgramWord>() { }
+	ProgramLine(int size): QVector<ProgramWord>(size) { }
+
+	void appendInstruction(Code code, unsigned subCode, quint32 operand = 0);
 };
 
 
 // class for holding the program code
-class ProgramCode : public QVector<ProgramWord>
+//
+//   - code is kept in a gap buffer where the gap is moved to the line being
+//     changed, so edits only move the words between the gap and the line
+//   - the gap is always at a line boundary, so each line is contiguous
+
+class ProgramCode
 {
 public:
-	ProgramCode(void): QVector<ProgramWord>() { }
-	ProgramCode(int size): QVector<ProgramWord>(size) { }
+	ProgramCode(void): m_gapBegin(0), m_gapEnd(0) { }
 
-	void insertLine(int i, const ProgramCode &line)
+	int size(void) const
 	{
-		if (line.size() > 0)
-		{
-			int oldSize = size();
-			resize(oldSize + line.size());
-			ProgramWord *lineBegin = data() + i;
-			if (i != oldSize)  // not inserting line at end?
-			{
-				// make hole in code for new line
-				memmove(lineBegin + line.size(), lineBegin, (oldSize - i)
-					* sizeof(ProgramWord));
-			}
-			// copy new line into program
-			memmove(lineBegin, line.data(), line.size() * sizeof(ProgramWord));
-		}
+		return m_words.size() - (m_gapEnd - m_gapBegin);
 	}
 
-	void removeLine(int i, int n)
+	// return pointer to the words of the line at an offset
+	const ProgramWord *lineData(int i) const
 	{
-		if (n > 0)  // something to remove?
-		{
-			remove(i, n);
-		}
+		return m_words.constData() + (i < m_gapBegin ? i
+			: i + m_gapEnd - m_gapBegin);
 	}
+	const ProgramWord *data(void);
+	ProgramWord *changeData(void);
 
-	void replaceLine(int i, int n, const ProgramCode &line)
+	void load(const ProgramWord *words, int size);
+	void clear(void)
 	{
-		if (line.count() == 0)
-		{
-			// no new line, just remove old line
-			removeLine(i, n);
-			return;
-		}
-		ProgramWord *offset;
-		if (line.count() > n)  // new line larger?
-		{
-			// make program larger before moving program after line up
-			resize(count() - n + line.count());
-			offset = data() + i;  // get data, resize may move data
-
-			int moveCount = count() - i - line.count();
-			if (moveCount > 0)  // not at end?
-			{
-				memmove(offset + line.count(), offset + n,
-					moveCount * sizeof(ProgramWord));
-			}
-		}
-		else  // new line smaller or same size
-		{
-			offset = data() + i;
-			if (line.count() < n)  // new line smaller?
-			{
-				// move program after line down before making program smaller
-				offset = data() + i;
-				int moveCount = count() - i - n;
-				if (moveCount > 0)  // not at end?
-				{
-					memmove(offset + line.count(), offset + n,
-						moveCount * sizeof(ProgramWord));
-				}
-				resize(count() - n + line.count());
-				offset = data() + i;  // get data again, resize may move data
-			}
-		}
-		// copy new line into program
-		memmove(offset, line.data(), line.count() * sizeof(ProgramWord));
+		m_words.clear();
+		m_gapBegin = m_gapEnd = 0;
 	}
+	void reserve(int size);
+	void appendInstruction(Code code, unsigned subCode, quint32 operand = 0);
+	int memory(void) const
+	{
+		// memory of the code including the gap (in bytes)
+		return m_words.capacity() * sizeof(ProgramWord);
+	}
+	void insertLine(int i, const ProgramLine &line);
+	void removeLine(int i, int n);
+	void replaceLine(int i, int n, const ProgramLine &line);
+
+private:
+	void moveGap(int i);
+	void reserveGap(int n);
+
+	QVector<ProgramWord> m_words;		// program words including gap
+	int m_gapBegin;						// offset of first word of gap
+	int m_gapEnd;						// offset of first word after gap
 };
 
 
@@ -169,14 +186,18 @@ public:
 		return m_remDictionary;
 	}
 
-	InfoDictionary<ConstNumInfo> *constNumDictionary(void) const
+	ConstNumDictionary *constNumDictionary(void) const
 	{
 		return m_constNumDictionary;
 	}
-	InfoDictionary<ConstStrInfo> *constStrDictionary(void) const
+	ConstStrDictionary *constStrDictionary(void) const
 	{
 		return m_constStrDictionary;
 	}
+	PrintConstDictionary *printConstDictionary(void) const
+	{
+		return m_printConstDictionary;
+	}
 
 	Dictionary *varDblDictionary(void) const
 	{
@@ -192,26 +213,28 @@ public:
 	}
 
 	QString operandText(Code code, int operand) const;
+	QString lineText(int lineIndex) const;
+	QString text(void) const;
+
+	void load(const QStringList &lines);
+	ProgramSnapshot snapshot(void) const;
+	QString memoryStats(void) const;
+	bool saveImage(const QString &fileName, const QString &source);
+	bool loadImage(const QString &fileName, const QString &source);
 
 	// NOTE temporary functions for testing
 	int lineOffset(int lineIndex) const
 	{
-		return m_lineInfo.at(lineIndex).offset;
+		return m_lineInfo.offset(lineIndex);
 	}
 	int lineSize(int lineIndex) const
 	{
 		return m_lineInfo.at(lineIndex).size;
 	}
-	const ErrorItem *lineError(int lineIndex) const
+	ErrorItem lineError(int lineIndex) const
 	{
-		if (m_lineInfo.at(lineIndex).errIndex == -1)
-		{
-			return NULL;
-		}
-		else
-		{
-			return &m_errors[m_lineInfo.at(lineIndex).errIndex];
-		}
+		int errIndex = m_errors.findIndex(lineIndex);
+		return errIndex == -1 ? ErrorItem() : m_errors.at(errIndex);
 	}
 	QString debugText(int lineIndex, bool fullInfo = false) const;
 	QString dictionariesDebugText(void);
@@ -223,56 +246,108 @@ signals:
 public slots:
 	void update(int lineNumber, int linesDeleted, int linesInserted,
 		QStringList lines);
+	void compact(void);
 
 private:
+	friend class ProgramSnapshot;
+
 	struct LineInfo
 	{
-		RpnList *rpnList;				// REMOVE pointer to rpn list
-		int offset;						// offset of line in program
+		RpnList *rpnList;				// REMOVE pointer to rpn list (NULL if
+										// line was loaded from an image)
 		int size;						// size of line in program
-		int errIndex;					// index to error list
+		QString errorText;				// text of line if line has error
 	};
-	class LineInfoList : public QList<LineInfo>
+
+	// class for holding the line information of the program
+	//
+	//   - lines are kept in a tree ordered by line index where each node
+	//     holds the number of lines and the code size of its sub-tree,
+	//     so finding a line or its offset, and inserting, removing or
+	//     changing the size of a line are all O(log n) operations
+	//   - the tree is balanced by random node priorities (treap)
+	//   - the nodes are kept in one vector with freed nodes being reused
+	//   - a whole list of lines is loaded in O(n) by building the tree along
+	//     its right spine instead of inserting each line
+
+	class LineInfoList
 	{
-		// adjust offset of all lines after index by size
-		void adjust(int i, int size)
+	public:
+		LineInfoList(void) : m_root(-1), m_seed(2463534242u) {}
+
+		int count(void) const
 		{
-			while (++i < count())
-			{
-				(*this)[i].offset += size;
-			}
+			return countOf(m_root);
 		}
-
-	public:
-		// replace size of line at index (adjust line offsets after index)
-		void replace(int i, int size)
+		const LineInfo &at(int i) const
 		{
-			adjust(i, size - at(i).size);
-			(*this)[i].size = size;
+			return m_nodes.at(find(i)).lineInfo;
 		}
-
-		// insert new line at index (adjust line offsets after index)
-		void insert(int i, const LineInfo &t)
+		const LineInfo &operator[](int i) const
 		{
-			QList<LineInfo>::insert(i, t);
-			adjust(i, t.size);
+			return m_nodes.at(find(i)).lineInfo;
 		}
+		LineInfo &operator[](int i)
+		{
+			return m_nodes[find(i)].lineInfo;
+		}
+		int offset(int i) const;
+		int memory(void) const;
+
+		void load(const QVector<LineInfo> &lineInfoList);
+		void replace(int i, int size);
+		void insert(int i, const LineInfo &lineInfo);
+		void removeAt(int i);
 
-		// remove line at index (adjust line offsets after index)
-		void removeAt(int i)
+	private:
+		struct Node
 		{
-			adjust(i, -at(i).size);
-			QList<LineInfo>::removeAt(i);
+			LineInfo lineInfo;			// information of line
+			int left;					// index of left child node
+			int right;					// index of right child node
+			unsigned priority;			// random priority of node
+			int count;					// number of lines in sub-tree
+			int codeSize;				// code size of lines in sub-tree
+		};
+
+		int countOf(int node) const
+		{
+			return node == -1 ? 0 : m_nodes.at(node).count;
+		}
+		int codeSizeOf(int node) const
+		{
+			return node == -1 ? 0 : m_nodes.at(node).codeSize;
 		}
+		int find(int i) const;
+		void update(int node);
+		void replace(int node, int i, int size);
+		void split(int node, int i, int &left, int &right);
+		int merge(int left, int right);
+		int newNode(const LineInfo &lineInfo);
+		unsigned random(void);
+
+		QVector<Node> m_nodes;			// nodes of the tree
+		QStack<int> m_freeStack;		// stack of free nodes
+		int m_root;						// index of root node
+		unsigned m_seed;				// random priority generator state
 	};
 
+	bool readImage(ImageReader &reader, const QString &source,
+		LineInfoList &lineInfo, ProgramCode &code, ErrorList &errors);
+	bool checkImageOperands(ProgramCode &code,
+		Dictionary *const *dictionaries);
 	bool updateLine(Operation operation, int lineNumber,
 		const QString &line = QString());
-	void updateError(int lineNumber, LineInfo &lineInfo,
-		const ErrorItem &errorItem, bool lineInserted);
-	void removeError(int lineNumber, LineInfo &lineInfo, bool lineDeleted);
-	ProgramCode encode(RpnList *input);
-	void dereference(const LineInfo &lineInfo);
+	void updateError(int lineNumber, const ErrorItem &errorItem,
+		bool lineInserted);
+	void removeError(int lineNumber, bool lineDeleted);
+	ProgramLine encode(RpnList *input);
+	int encodeAppend(RpnList *input);
+	Code encodeToken(Token *token, quint32 *operand);
+	void dereference(int lineIndex);
+	void newDictionaries(void);
+	void deleteDictionaries(void);
+	void compactStrings(void);
 
 	Table &m_table;						// reference to the table object
 	Translator *m_translator;			// program line translator instance
@@ -282,10 +357,14 @@ private:
 	ProgramCode m_code;					// code for program unit lines
 	ErrorList m_errors;					// list of program errors
 
+	// pointer to the string arena holding the keys of the dictionaries
+	StringArena *m_strings;
+
 	// pointers to the global program dictionaries
 	Dictionary *m_remDictionary;
-	InfoDictionary<ConstNumInfo> *m_constNumDictionary;
+	ConstNumDictionary *m_constNumDictionary;
 	ConstStrDictionary *m_constStrDictionary;
+	PrintConstDictionary *m_printConstDictionary;
 
 	// pointers to the local unit dictionaries
 	Dictionary *m_varDblDictionary;
@@ -294,4 +373,96 @@ private:
 };
 
 
+// class for holding a snapshot of a program unit
+//
+//   - a snapshot holds the line information, code and dictionaries of the
+//     program at the time the snapshot was taken, which are not changed by
+//     edits of the program, so a program can be run while it is edited
+//   - the containers of the program are implicitly shared, so taking a
+//     snapshot does not copy the program, the program copies a container
+//     when it is first changed after a snapshot is taken
+//   - copies of a snapshot share its data (the dictionaries of the data
+//     point to the string arena of the data), the program held is released
+//     when the last copy is destroyed
+//   - the rpn lists of the line information are not valid in a snapshot
+
+class ProgramSnapshot
+{
+public:
+	int lineCount(void) const
+	{
+		return m_data->lineInfo.count();
+	}
+	int lineSize(int lineIndex) const
+	{
+		return m_data->lineInfo.at(lineIndex).size;
+	}
+	bool lineHasError(int lineIndex) const
+	{
+		return !m_data->lineInfo.at(lineIndex).errorText.isNull();
+	}
+	const ProgramWord *lineCode(int lineIndex) const
+	{
+		return m_data->code.lineData(m_data->lineInfo.offset(lineIndex));
+	}
+
+	const Dictionary &remDictionary(void) const
+	{
+		return m_data->remDictionary;
+	}
+	const ConstNumDictionary &constNumDictionary(void) const
+	{
+		return m_data->constNumDictionary;
+	}
+	const ConstStrDictionary &constStrDictionary(void) const
+	{
+		return m_data->constStrDictionary;
+	}
+	const PrintConstDictionary &printConstDictionary(void) const
+	{
+		return m_data->printConstDictionary;
+	}
+	const Dictionary &varDblDictionary(void) const
+	{
+		return m_data->varDblDictionary;
+	}
+	const Dictionary &varIntDictionary(void) const
+	{
+		return m_data->varIntDictionary;
+	}
+	const Dictionary &varStrDictionary(void) const
+	{
+		return m_data->varStrDictionary;
+	}
+
+private:
+	friend class ProgramModel;
+	explicit ProgramSnapshot(const ProgramModel &programModel);
+
+	struct Data
+	{
+		explicit Data(const ProgramModel &programModel);
+
+		ProgramModel::LineInfoList lineInfo;	// program line information
+		ProgramCode code;				// code for program unit lines
+		StringArena strings;			// keys of the dictionaries
+
+		// copies of the program dictionaries
+		Dictionary remDictionary;
+		ConstNumDictionary constNumDictionary;
+		ConstStrDictionary constStrDictionary;
+		PrintConstDictionary printConstDictionary;
+		Dictionary varDblDictionary;
+		Dictionary varIntDictionary;
+		Dictionary varStrDictionary;
+
+	private:
+		Data(const Data &);				// not copyable (see above)
+		Data &operator=(const Data &);
+	};
+
+	QSharedPointer<const Data> m_data;	// data shared by snapshot copies
+};
+
+
 #endif // PROGRAMMODEL_H
@@ -0,0 +1,229 @@
+// vim:ts=4:sw=4:
+//
+//	Interactive BASIC Compiler Project
+//	File: recreator.cpp - recreator class source file
+//	Copyright (C) 2013  Thunder422
+//
+//	This program is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	This program is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU General Public License for more details.
+//
+//	For a copy of the GNU General Public License,
+//	see <http://www.gnu.org/licenses/>.
+//
+//
+//	Change History:
+//
+//	2013-10-12	initial version
+
+#include "recreator.h"
+#include "programmodel.h"
+#include "table.h"
+
+
+Recreator::Recreator(const ProgramModel *programUnit) :
+	m_table(Table::instance()),
+	m_programUnit(programUnit),
+	m_word(NULL)
+{
+
+}
+
+
+// function to recreate the text of a program line from its program code
+QString Recreator::recreate(const ProgramWord *line, int count)
+{
+	m_output.clear();
+	for (int i = 0; i < count; i++)
+	{
+		m_word = &line[i];
+		Code code = m_word->instructionCode();
+
+		RecreateFunction recreate = m_table.recreateFunction(code);
+		if (recreate != NULL)
+		{
+			recreate(*this, code);
+		}
+		else  // recreate code by its type
+		{
+			switch (m_table.type(code))
+			{
+			case Operator_TokenType:
+				operatorRecreate(code);
+				break;
+			case IntFuncN_TokenType:
+			case IntFuncP_TokenType:
+				functionRecreate(code);
+				break;
+			case Constant_TokenType:
+			case NoParen_TokenType:
+				push(operandText());
+				break;
+			default:
+				append(m_table.name(code));
+				break;
+			}
+		}
+
+		if (hasSubCode(Paren_SubCode))
+		{
+			topAddParens();  // recreate unnecessary parentheses entered
+		}
+		if (hasSubCode(Colon_SubCode))
+		{
+			append(": ");  // recreate end of statement
+		}
+		if (m_word->hasWideOperand())
+		{
+			i++;  // skip wide operand word
+		}
+	}
+	m_stack.clear();  // should already be empty
+	return m_output;
+}
+
+
+//============================================
+//  CURRENT PROGRAM WORD ACCESS FUNCTIONS
+//============================================
+
+// function to check if current instruction has a sub-code
+bool Recreator::hasSubCode(int subCode) const
+{
+	return m_word->instructionHasSubCode(subCode);
+}
+
+
+// function to return the operand of the current instruction
+quint32 Recreator::operand(void) const
+{
+	return m_word->operand();
+}
+
+
+// function to return the text of the operand of the current instruction
+QString Recreator::operandText(void) const
+{
+	return m_programUnit->operandText(m_word->instructionCode(),
+		m_word->operand());
+}
+
+
+//===========================
+//  STACK ACCESS FUNCTIONS
+//===========================
+
+// function to push a string with its precedence on to the stack
+void Recreator::push(const QString &string, int precedence)
+{
+	m_stack.resize(m_stack.size() + 1);
+	m_stack.top().string = string;
+	m_stack.top().precedence = precedence;
+}
+
+
+// function to pop the string from the top of the stack
+QString Recreator::pop(void)
+{
+	return m_stack.pop().string;
+}
+
+
+// function to pop an operand of an operator from the top of the stack
+//
+//   - parentheses are added if the precedence of the operand is lower than
+//     the operator (or the same for the last operand since the operators
+//     are evaluated from left to right)
+
+QString Recreator::popOperand(int precedence, bool lastOperand)
+{
+	bool parens = topPrecedence() < precedence
+		|| lastOperand && topPrecedence() == precedence;
+	QString string = pop();
+	return parens ? "(" + string + ")" : string;
+}
+
+
+// function to add parentheses around the string on top of the stack
+void Recreator::topAddParens(void)
+{
+	m_stack.top().string.prepend('(').append(')');
+	m_stack.top().precedence = HighestPrecedence;
+}
+
+
+//=============================
+//  DEFAULT RECREATE FUNCTIONS
+//=============================
+
+// function to recreate a unary or binary operator
+void Recreator::operatorRecreate(Code code)
+{
+	int precedence = m_table.precedence(code);
+	QString name = m_table.name(code);
+
+	if (m_table.operandCount(code) == 1)  // unary operator?
+	{
+		QString operand = popOperand(precedence, false);
+		if (name.at(name.length() - 1).isLetter()
+			|| operand.at(0).isDigit() || operand.at(0) == '.')
+		{
+			// separate word operator from operand and operator from a
+			// constant (so it is not recreated as a negative constant)
+			name.append(' ');
+		}
+		push(name + operand, precedence);
+	}
+	else  // binary operator
+	{
+		QString string = popOperand(precedence, true);
+		string.prepend(popOperand(precedence, false) + ' ' + name + ' ');
+		push(string, precedence);
+	}
+}
+
+
+// function to recreate an internal function
+void Recreator::functionRecreate(Code code)
+{
+	QString name = m_table.name(code);
+
+	if (name.isEmpty())
+	{
+		return;  // internal code, nothing to recreate
+	}
+	if (m_table.type(code) == IntFuncN_TokenType)
+	{
+		push(name);  // no arguments
+	}
+	else  // function with arguments (name includes opening parentheses)
+	{
+		QString string = pop();
+		for (int count = m_table.operandCount(code); --count > 0;)
+		{
+			string.prepend(pop() + ',');
+		}
+		push(name + string + ')');
+	}
+}
+
+
+//=====================
+//  RECREATE FUNCTIONS
+//=====================
+
+// function to recreate a set of parentheses entered around an expression
+// that already has a set of unnecessary parentheses
+void parenRecreate(Recreator &recreator, Code code)
+{
+	recreator.topAddParens();
+}
+
+
+// end: recreator.cpp
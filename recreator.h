@@ -0,0 +1,123 @@
+// vim:ts=4:sw=4:
+//
+//	Interactive BASIC Compiler Project
+//	File: recreator.h - recreator class header file
+//	Copyright (C) 2013  Thunder422
+//
+//	This program is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	This program is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU General Public License for more details.
+//
+//	For a copy of the GNU General Public License,
+//	see <http://www.gnu.org/licenses/>.
+//
+//
+//	Change History:
+//
+//	2013-10-12	initial version
+
+#ifndef RECREATOR_H
+#define RECREATOR_H
+
+#include <QStack>
+#include <QString>
+
+#include "ibcp.h"
+#include "table.h"
+
+class ProgramModel;
+class ProgramWord;
+
+
+// class for recreating the text of a program line from its program code
+//
+//   - the program code of a line is in reverse polish notation, so the
+//     text is recreated using a stack of strings, where operands are
+//     pushed and operators and functions pop their operands and push
+//     their resulting string
+//   - each string on the stack holds the precedence of its expression,
+//     which is used to add the necessary parentheses (unnecessary
+//     parentheses entered are recreated from the parentheses sub-code)
+//   - codes with a recreate function in the table are recreated by that
+//     function, other codes are recreated by their type
+
+class Recreator
+{
+	struct StackItem
+	{
+		QString string;				// string of stack item
+		int precedence;				// precedence of stack item
+	};
+
+public:
+	explicit Recreator(const ProgramModel *programUnit);
+
+	// Main Function
+	QString recreate(const ProgramWord *line, int count);
+
+	// Table Access Function
+	Table &table(void) const
+	{
+		return m_table;
+	}
+
+	// Current Program Word Access Functions
+	bool hasSubCode(int subCode) const;
+	quint32 operand(void) const;
+	QString operandText(void) const;
+
+	// Stack Access Functions
+	void push(const QString &string, int precedence = HighestPrecedence);
+	QString pop(void);
+	QString popOperand(int precedence, bool lastOperand);
+	bool stackIsEmpty(void) const
+	{
+		return m_stack.isEmpty();
+	}
+	const QString &topString(void) const
+	{
+		return m_stack.top().string;
+	}
+	int topPrecedence(void) const
+	{
+		return m_stack.top().precedence;
+	}
+	void topAppend(const QString &string)
+	{
+		m_stack.top().string.append(string);
+	}
+	void topAddParens(void);
+
+	// Output Access Functions
+	void append(const QString &string)
+	{
+		m_output.append(string);
+	}
+	const QString &output(void) const
+	{
+		return m_output;
+	}
+
+private:
+	void operatorRecreate(Code code);
+	void functionRecreate(Code code);
+
+	Table &m_table;					// reference to the table instance
+	const ProgramModel *m_programUnit;	// program unit of the line
+	const ProgramWord *m_word;		// current program word of the line
+	QStack<StackItem> m_stack;		// stack of strings being recreated
+	QString m_output;				// recreated text of the line
+};
+
+
+// recreate functions
+void parenRecreate(Recreator &recreator, Code code);
+
+
+#endif  // RECREATOR_H
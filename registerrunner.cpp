@@ -0,0 +1,1191 @@
+// vim:ts=4:sw=4:
+//
+//	Interactive BASIC Compiler Project
+//	File: registerrunner.cpp - register runner class source file
+//	Copyright (C) 2013  Thunder422
+//
+//	This program is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	This program is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU General Public License for more details.
+//
+//	For a copy of the GNU General Public License,
+//	see <http://www.gnu.org/licenses/>.
+//
+//
+//	Change History:
+//
+//	2013-11-09	initial version
+
+#include "registerrunner.h"
+#include "table.h"
+#include "basic/basic.h"
+
+
+RegisterRunner::RegisterRunner(const ProgramSnapshot &program) :
+	Runner(program),
+	m_inputPrompt("? ")
+{
+
+}
+
+
+// function to check the program and lower its code to register code
+bool RegisterRunner::check(void)
+{
+	if (!Runner::check())
+	{
+		return false;
+	}
+	lower();
+	return true;
+}
+
+
+// function to count the instructions of the program code and of the register
+// code lowered from it (for comparing the two codes)
+//
+//   - lines with errors have no code, so they are not counted
+
+int RegisterRunner::instructionCount(int *programCount)
+{
+	int maxSize = 0;
+	*programCount = 0;
+	for (int i = 0; i < m_program.lineCount(); i++)
+	{
+		const ProgramWord *line = m_program.lineCode(i);
+		int size = m_program.lineSize(i);
+		for (int j = 0; j < size; j++)
+		{
+			if (line[j].hasWideOperand())
+			{
+				j++;  // skip wide operand word
+			}
+			++*programCount;
+		}
+		maxSize = qMax(maxSize, size);
+	}
+	allocate(maxSize);
+	lower();
+	return m_code.size();
+}
+
+
+//======================
+//  LOWERING FUNCTIONS
+//======================
+
+// function to lower the code of the program to register code
+//
+//   - the values of the operands not held by the program (immediate
+//     constants and the data types of input statements) are reserved for
+//     the size of the code, so the pointers to them remain valid
+//   - the values of the string and print constants are only set for the
+//     entries used (a removed entry has no value)
+//   - the stacks used for lowering a line are reserved for the largest line
+//     (the size of the stacks of the runner), so they are not allocated
+//     again for each line
+
+void RegisterRunner::lower(void)
+{
+	int codeSize = 0;
+	for (int i = 0; i < m_program.lineCount(); i++)
+	{
+		codeSize += m_program.lineSize(i);
+	}
+	m_code.clear();
+	m_code.reserve(codeSize);
+	m_lineBegin.clear();
+	m_lineBegin.reserve(m_program.lineCount() + 1);
+	m_immediate.clear();
+	m_immediate.reserve(codeSize);
+	m_immediateInt.clear();
+	m_immediateInt.reserve(codeSize);
+	m_inputType.clear();
+	m_inputType.reserve(codeSize);
+	for (int i = 0; i < numberof_DataType; i++)
+	{
+		m_lowerStack[i].reserve(m_dblStack.size());
+	}
+	m_lowerRefStack.reserve(m_dblStack.size());
+	m_lowerInputType.reserve(m_dblStack.size());
+	m_constStr = QVector<QString>(m_program.constStrDictionary().count());
+	m_printConst = QVector<QString>(m_program.printConstDictionary().count());
+
+	for (int i = 0; i < m_program.lineCount(); i++)
+	{
+		m_lineBegin.append(m_code.size());
+		lowerLine(i);
+	}
+	m_lineBegin.append(m_code.size());
+}
+
+
+// function to lower the code of a line to register instructions
+//
+//   - the stacks of the program code are followed with stacks of operands,
+//     an operand code pushes a pointer to its value, an instruction pops
+//     its operands and pushes its result register (the register of the
+//     stack item of the result)
+//   - the operands and result of an instruction are obtained from the
+//     table (the number and data types of the operands and the data type of
+//     the result), only the codes that are not operators or functions are
+//     lowered differently
+//   - an assignment is stored into the result of the last instruction when
+//     it produced the value assigned (a register), otherwise the assignment
+//     is an instruction that copies the value
+//   - the value of a keep assignment is assigned by more than one
+//     instruction, a string variable value is copied to its register first
+//     so that the assignments do not see the changes of the previous
+//     assignments (the value is read when the instruction is run)
+
+void RegisterRunner::lowerLine(int lineIndex)
+{
+	QStack<const void *> *stack = m_lowerStack;
+	QStack<void *> &refStack = m_lowerRefStack;
+	QVector<DataType> &inputTypes = m_lowerInputType;
+	for (int i = 0; i < numberof_DataType; i++)
+	{
+		stack[i].resize(0);
+	}
+	refStack.resize(0);
+	inputTypes.resize(0);
+	int inputIndex[numberof_DataType] = {0};
+	int lineBegin = m_code.size();
+
+	const ProgramWord *word = m_program.lineCode(lineIndex);
+	const ProgramWord *end = word + m_program.lineSize(lineIndex);
+	for (; word < end; word += word->hasWideOperand() ? 2 : 1)
+	{
+		Code code = word->instructionCode();
+		Instruction instruction = {code, 0, NULL, {NULL, NULL, NULL}};
+		DataType dataType = m_table.dataType(code);
+		switch (code)
+		{
+		// codes with nothing to run
+		case Let_Code:
+		case Rem_Code:
+		case RemOp_Code:
+		case CloseParen_Code:
+		case Colon_Code:
+		case EOL_Code:
+		case SemiColon_Code:
+		case Input_Code:
+		case InputPrompt_Code:
+			continue;
+
+		// operand codes (not instructions)
+		case Const_Code:
+			stack[Double_DataType].push(m_constValue
+				+ m_constIndex[word->operand()]);
+			continue;
+		case ConstInt_Code:
+			stack[Integer_DataType].push(m_constValueInt
+				+ m_constIndex[word->operand()]);
+			continue;
+		case ConstStr_Code:
+		{
+			QString &value = m_constStr[word->operand()];
+			if (value.isNull())
+			{
+				value = m_program.constStrDictionary().value(word->operand());
+			}
+			stack[String_DataType].push(&value);
+			continue;
+		}
+		case ConstImm_Code:
+			m_immediate.append(word->operand());
+			stack[Double_DataType].push(&m_immediate.last());
+			continue;
+		case ConstIntImm_Code:
+			m_immediateInt.append(word->operand());
+			stack[Integer_DataType].push(&m_immediateInt.last());
+			continue;
+		case Var_Code:
+			stack[Double_DataType].push(&m_varDbl[word->operand()]);
+			continue;
+		case VarInt_Code:
+			stack[Integer_DataType].push(&m_varInt[word->operand()]);
+			continue;
+		case VarStr_Code:
+			stack[String_DataType].push(&m_varStr[word->operand()]);
+			continue;
+		case VarRef_Code:
+			refStack.push(&m_varDbl[word->operand()]);
+			continue;
+		case VarRefInt_Code:
+			refStack.push(&m_varInt[word->operand()]);
+			continue;
+		case VarRefStr_Code:
+			refStack.push(&m_varStr[word->operand()]);
+			continue;
+
+		// hidden conversion codes (not in the table as functions)
+		case CvtInt_Code:
+			instruction.operand[0] = stack[Double_DataType].pop();
+			dataType = Integer_DataType;
+			break;
+		case CvtDbl_Code:
+			instruction.operand[0] = stack[Integer_DataType].pop();
+			dataType = Double_DataType;
+			break;
+
+		// (the strings are concatenated by an instruction for each string
+		// after the first into the register of the first string)
+		case CatStrs_Code:
+		{
+			int count = word->operand();
+			QStack<const void *> &strings = stack[String_DataType];
+			int first = strings.size() - count;
+			void *result = registerOperand(String_DataType, first);
+			instruction.code = CatStr_Code;
+			instruction.result = result;
+			for (int i = first + 1; i < strings.size(); i++)
+			{
+				instruction.operand[0] = i == first + 1 ? strings.at(first)
+					: result;
+				instruction.operand[1] = strings.at(i);
+				m_code.append(instruction);
+			}
+			strings.resize(first);
+			strings.push(result);
+			continue;
+		}
+
+		case Assign_Code:
+		case AssignInt_Code:
+		case AssignStr_Code:
+		{
+			const void *value = stack[dataType].pop();
+			void *variable = refStack.pop();
+			if (m_code.size() > lineBegin && m_code.last().result == value
+				&& value == registerOperand(dataType,
+				stack[dataType].size()))
+			{
+				m_code.last().result = variable;
+				continue;
+			}
+			instruction.result = variable;
+			instruction.operand[0] = value;
+			m_code.append(instruction);
+			continue;
+		}
+
+		// (the list assignments become an assignment for each reference)
+		case AssignList_Code:
+		case AssignListInt_Code:
+		case AssignListStr_Code:
+			instruction.operand[0] = stack[dataType].pop();
+			while (!refStack.isEmpty())
+			{
+				instruction.result = refStack.pop();
+				m_code.append(instruction);
+			}
+			continue;
+
+		case AssignKeepStr_Code:
+		case AssignLeft_Code:
+		case AssignKeepLeft_Code:
+		case AssignMid2_Code:
+		case AssignKeepMid2_Code:
+		case AssignMid3_Code:
+		case AssignKeepMid3_Code:
+		case AssignRight_Code:
+		case AssignKeepRight_Code:
+		{
+			QStack<const void *> &strings = stack[String_DataType];
+			const void *value = strings.top();
+			const QString *varStr = m_varStr.constData();
+			bool keep = code == AssignKeepStr_Code
+				|| code == AssignKeepLeft_Code || code == AssignKeepMid2_Code
+				|| code == AssignKeepMid3_Code || code == AssignKeepRight_Code;
+			if (keep && value >= varStr && value < varStr + m_varStr.size())
+			{
+				// (copy of variable value, same as the program code)
+				Instruction copy = {VarStr_Code, 0,
+					registerOperand(String_DataType, strings.size() - 1),
+					{value, NULL, NULL}};
+				m_code.append(copy);
+				value = strings.top() = copy.result;
+			}
+			if (code == AssignMid3_Code || code == AssignKeepMid3_Code)
+			{
+				instruction.operand[2] = stack[Integer_DataType].pop();
+			}
+			if (code != AssignKeepStr_Code)
+			{
+				instruction.operand[1] = stack[Integer_DataType].pop();
+			}
+			instruction.result = refStack.pop();
+			instruction.operand[0] = value;
+			m_code.append(instruction);
+			if (!keep)
+			{
+				strings.pop();  // (last assignment of value)
+			}
+			continue;
+		}
+
+		case PrintConst_Code:
+		{
+			QString &value = m_printConst[word->operand()];
+			if (value.isNull())
+			{
+				value = m_program.printConstDictionary()
+					.value(word->operand());
+			}
+			instruction.operand[0] = &value;
+			m_code.append(instruction);
+			continue;
+		}
+
+		// (the data types of the input values are set by the parse codes,
+		// the input begin instruction holds them, each input assign
+		// instruction holds the index of its value)
+		case InputParse_Code:
+			inputTypes.append(Double_DataType);
+			continue;
+		case InputParseInt_Code:
+			inputTypes.append(Integer_DataType);
+			continue;
+		case InputParseStr_Code:
+			inputTypes.append(String_DataType);
+			continue;
+
+		case InputBegin_Code:
+		case InputBeginStr_Code:
+			if (code == InputBegin_Code)
+			{
+				instruction.operand[0] = &m_inputPrompt;
+			}
+			else  // InputBeginStr_Code
+			{
+				instruction.operand[0] = stack[String_DataType].pop();
+				if (word->instructionHasSubCode(Option_SubCode))
+				{
+					instruction.operand[2] = &m_inputPrompt;
+				}
+			}
+			instruction.count = inputTypes.size();
+			instruction.operand[1] = m_inputType.constData()
+				+ m_inputType.size();
+			for (int i = 0; i < inputTypes.size(); i++)
+			{
+				// (appended within the reserved size, see lower)
+				m_inputType.append(inputTypes.at(i));
+			}
+			m_code.append(instruction);
+			inputTypes.resize(0);
+			for (int i = 0; i < numberof_DataType; i++)
+			{
+				inputIndex[i] = 0;
+			}
+			continue;
+
+		case InputAssign_Code:
+		case InputAssignInt_Code:
+		case InputAssignStr_Code:
+			dataType = code == InputAssign_Code ? Double_DataType
+				: code == InputAssignInt_Code ? Integer_DataType
+				: String_DataType;
+			instruction.count = inputIndex[dataType]++;
+			instruction.result = refStack.pop();
+			m_code.append(instruction);
+			continue;
+
+		// operators, functions and commands
+		default:
+			for (int i = m_table.operandCount(code); --i >= 0;)
+			{
+				QStack<const void *> &operands
+					= stack[m_table.operandDataType(code, i)];
+				instruction.operand[i] = operands.pop();
+			}
+			break;
+		}
+
+		if (dataType < numberof_DataType)
+		{
+			instruction.result = registerOperand(dataType,
+				stack[dataType].size());
+			stack[dataType].push(instruction.result);
+		}
+		m_code.append(instruction);
+	}
+}
+
+
+// function to return the register of an item of the stack of a data type
+void *RegisterRunner::registerOperand(DataType dataType, int index)
+{
+	switch (dataType)
+	{
+	case Double_DataType:
+		return m_dblStack.data() + index;
+	case Integer_DataType:
+		return m_intStack.data() + index;
+	default:  // String_DataType
+		return m_strStack.data() + index;
+	}
+}
+
+
+//=====================
+//  LINE RUN FUNCTIONS
+//=====================
+
+// function to run a line of the program (returns false to stop the program)
+bool RegisterRunner::runLine(int lineIndex)
+{
+	const Instruction *code = m_code.constData();
+	return runCode(code + m_lineBegin.at(lineIndex),
+		code + m_lineBegin.at(lineIndex + 1));
+}
+
+
+// macros for the dispatch of the handlers (see Runner::runCode)
+#define HANDLER(code)  code##_Handler
+
+#ifdef __GNUC__
+#define DISPATCH  goto *dispatchTable[instruction->code]
+#else
+#define DISPATCH  goto dispatch
+#endif
+
+#define NEXT \
+	do { \
+		if (++instruction == end) \
+		{ \
+			return true; \
+		} \
+		DISPATCH; \
+	} while (0)
+
+
+// macros for the result and operands of the current instruction
+#define DBL_RESULT  (*(double *)instruction->result)
+#define INT_RESULT  (*(int *)instruction->result)
+#define STR_RESULT  (*(QString *)instruction->result)
+#define DBL_OPERAND(n)  (*(const double *)instruction->operand[n])
+#define INT_OPERAND(n)  (*(const int *)instruction->operand[n])
+#define STR_OPERAND(n)  (*(const QString *)instruction->operand[n])
+
+
+// macro for the handlers of the forms of a comparison operator
+//
+//   - the result is -1 for true and 0 for false (integer)
+//   - the I1 form has an integer first operand, the I2 form has an integer
+//     second operand (the other operand is a double)
+
+#define COMPARE_HANDLERS(name, op) \
+	HANDLER(name##_Code): \
+		INT_RESULT = -(DBL_OPERAND(0) op DBL_OPERAND(1)); \
+		NEXT; \
+	HANDLER(name##I1_Code): \
+		INT_RESULT = -(INT_OPERAND(0) op DBL_OPERAND(1)); \
+		NEXT; \
+	HANDLER(name##I2_Code): \
+		INT_RESULT = -(DBL_OPERAND(0) op INT_OPERAND(1)); \
+		NEXT; \
+	HANDLER(name##Int_Code): \
+		INT_RESULT = -(INT_OPERAND(0) op INT_OPERAND(1)); \
+		NEXT; \
+	HANDLER(name##Str_Code): \
+		INT_RESULT = -(QString::compare(STR_OPERAND(0), STR_OPERAND(1)) \
+			op 0); \
+		NEXT;
+
+
+// function to run the register code of a line (returns false to stop the
+// program)
+//
+//   - the handlers run the same as the handlers of the program code (see
+//     Runner::runCode) with their operands and result from the instruction
+//   - a handler reads all of its operands before storing its result (the
+//     result may be one of the operands)
+//   - each handler is in its own block so that jumps to the handlers do not
+//     skip the initialization of any variables of the other handlers
+
+bool RegisterRunner::runCode(const Instruction *instruction,
+	const Instruction *end)
+{
+#ifdef __GNUC__
+	static const void *const dispatchTable[sizeof_Code] = {
+#define RunHandler(code)  &&HANDLER(code),
+#include "autohandlers.h"
+#undef RunHandler
+	};
+#endif
+
+	if (instruction == end)
+	{
+		return true;  // blank line
+	}
+	DISPATCH;
+
+#ifndef __GNUC__
+dispatch:
+	switch (instruction->code)
+	{
+#define RunHandler(code)  case code: goto HANDLER(code);
+#include "autohandlers.h"
+#undef RunHandler
+	}
+#endif
+
+	// codes that are not program instructions (or not used)
+	HANDLER(Null_Code):
+	HANDLER(BegPlainWord_Code):
+	HANDLER(EndPlainWord_Code):
+	HANDLER(BegParenWord_Code):
+	HANDLER(EndParenWord_Code):
+	HANDLER(BegDataTypeWord_Code):
+	HANDLER(EndDataTypeWord_Code):
+	HANDLER(BegSymbol_Code):
+	HANDLER(EndSymbol_Code):
+	HANDLER(OpenParen_Code):
+	HANDLER(CatStrs_Code):
+	HANDLER(Const_Code):
+	HANDLER(ConstInt_Code):
+	HANDLER(ConstStr_Code):
+	HANDLER(ConstImm_Code):
+	HANDLER(ConstIntImm_Code):
+	HANDLER(Var_Code):
+	HANDLER(VarInt_Code):
+	HANDLER(VarRef_Code):
+	HANDLER(VarRefInt_Code):
+	HANDLER(VarRefStr_Code):
+		return error(tr("invalid code"));
+
+	// commands not implemented yet
+	HANDLER(Dim_Code):
+	HANDLER(Def_Code):
+	HANDLER(If_Code):
+	HANDLER(Then_Code):
+	HANDLER(Else_Code):
+	HANDLER(EndIf_Code):
+	HANDLER(For_Code):
+	HANDLER(To_Code):
+	HANDLER(Step_Code):
+	HANDLER(Next_Code):
+	HANDLER(Do_Code):
+	HANDLER(DoWhile_Code):
+	HANDLER(DoUntil_Code):
+	HANDLER(While_Code):
+	HANDLER(Until_Code):
+	HANDLER(Loop_Code):
+	HANDLER(LoopWhile_Code):
+	HANDLER(LoopUntil_Code):
+		return error(tr("%1 not implemented")
+			.arg(m_table.name(instruction->code)));
+
+	// codes with nothing to run (not lowered to instructions)
+	HANDLER(Let_Code):
+	HANDLER(Rem_Code):
+	HANDLER(RemOp_Code):
+	HANDLER(CloseParen_Code):
+	HANDLER(Colon_Code):
+	HANDLER(EOL_Code):
+	HANDLER(SemiColon_Code):
+	HANDLER(InputParse_Code):
+	HANDLER(InputParseInt_Code):
+	HANDLER(InputParseStr_Code):
+	HANDLER(Input_Code):
+	HANDLER(InputPrompt_Code):
+		NEXT;
+
+	HANDLER(End_Code):
+		return false;  // end of program (no error)
+
+	// (copy of a string variable value, see lowerLine)
+	HANDLER(VarStr_Code):
+		STR_RESULT = STR_OPERAND(0);
+		NEXT;
+
+	//-----------------------
+	//  NUMERIC OPERATORS
+	//-----------------------
+
+	HANDLER(Add_Code):
+		DBL_RESULT = DBL_OPERAND(0) + DBL_OPERAND(1);
+		NEXT;
+	HANDLER(AddI1_Code):
+		DBL_RESULT = INT_OPERAND(0) + DBL_OPERAND(1);
+		NEXT;
+	HANDLER(AddI2_Code):
+		DBL_RESULT = DBL_OPERAND(0) + INT_OPERAND(1);
+		NEXT;
+	HANDLER(AddInt_Code):
+	{
+		double result = (double)INT_OPERAND(0) + INT_OPERAND(1);
+		if (!fitsInt(result))
+		{
+			return error(tr("overflow"));
+		}
+		INT_RESULT = (int)result;
+		NEXT;
+	}
+
+	HANDLER(Sub_Code):
+		DBL_RESULT = DBL_OPERAND(0) - DBL_OPERAND(1);
+		NEXT;
+	HANDLER(SubI1_Code):
+		DBL_RESULT = INT_OPERAND(0) - DBL_OPERAND(1);
+		NEXT;
+	HANDLER(SubI2_Code):
+		DBL_RESULT = DBL_OPERAND(0) - INT_OPERAND(1);
+		NEXT;
+	HANDLER(SubInt_Code):
+	{
+		double result = (double)INT_OPERAND(0) - INT_OPERAND(1);
+		if (!fitsInt(result))
+		{
+			return error(tr("overflow"));
+		}
+		INT_RESULT = (int)result;
+		NEXT;
+	}
+
+	HANDLER(Mul_Code):
+		DBL_RESULT = DBL_OPERAND(0) * DBL_OPERAND(1);
+		NEXT;
+	HANDLER(MulI1_Code):
+		DBL_RESULT = INT_OPERAND(0) * DBL_OPERAND(1);
+		NEXT;
+	HANDLER(MulI2_Code):
+		DBL_RESULT = DBL_OPERAND(0) * INT_OPERAND(1);
+		NEXT;
+	HANDLER(MulInt_Code):
+	{
+		double result = (double)INT_OPERAND(0) * INT_OPERAND(1);
+		if (!fitsInt(result))
+		{
+			return error(tr("overflow"));
+		}
+		INT_RESULT = (int)result;
+		NEXT;
+	}
+
+	HANDLER(Div_Code):
+		if (DBL_OPERAND(1) == 0)
+		{
+			return error(tr("division by zero"));
+		}
+		DBL_RESULT = DBL_OPERAND(0) / DBL_OPERAND(1);
+		NEXT;
+	HANDLER(DivI1_Code):
+		if (DBL_OPERAND(1) == 0)
+		{
+			return error(tr("division by zero"));
+		}
+		DBL_RESULT = INT_OPERAND(0) / DBL_OPERAND(1);
+		NEXT;
+	HANDLER(DivI2_Code):
+		if (INT_OPERAND(1) == 0)
+		{
+			return error(tr("division by zero"));
+		}
+		DBL_RESULT = DBL_OPERAND(0) / INT_OPERAND(1);
+		NEXT;
+	HANDLER(DivInt_Code):
+		if (INT_OPERAND(1) == 0)
+		{
+			return error(tr("division by zero"));
+		}
+		if (INT_OPERAND(1) == -1)
+		{
+			if (!fitsInt(-(double)INT_OPERAND(0)))
+			{
+				return error(tr("overflow"));
+			}
+			INT_RESULT = -INT_OPERAND(0);
+			NEXT;
+		}
+		INT_RESULT = INT_OPERAND(0) / INT_OPERAND(1);
+		NEXT;
+	HANDLER(IntDiv_Code):
+	{
+		if (DBL_OPERAND(1) == 0)
+		{
+			return error(tr("division by zero"));
+		}
+		double result = DBL_OPERAND(0) / DBL_OPERAND(1);
+		result = result < 0 ? ceil(result) : floor(result);
+		if (!fitsInt(result))
+		{
+			return error(tr("overflow"));
+		}
+		INT_RESULT = (int)result;
+		NEXT;
+	}
+
+	HANDLER(Mod_Code):
+		if (DBL_OPERAND(1) == 0)
+		{
+			return error(tr("division by zero"));
+		}
+		DBL_RESULT = fmod(DBL_OPERAND(0), DBL_OPERAND(1));
+		NEXT;
+	HANDLER(ModI1_Code):
+		if (DBL_OPERAND(1) == 0)
+		{
+			return error(tr("division by zero"));
+		}
+		DBL_RESULT = fmod(INT_OPERAND(0), DBL_OPERAND(1));
+		NEXT;
+	HANDLER(ModI2_Code):
+		if (INT_OPERAND(1) == 0)
+		{
+			return error(tr("division by zero"));
+		}
+		DBL_RESULT = fmod(DBL_OPERAND(0), INT_OPERAND(1));
+		NEXT;
+	HANDLER(ModInt_Code):
+		if (INT_OPERAND(1) == 0)
+		{
+			return error(tr("division by zero"));
+		}
+		INT_RESULT = INT_OPERAND(1) == -1 ? 0
+			: INT_OPERAND(0) % INT_OPERAND(1);
+		NEXT;
+
+	HANDLER(Power_Code):
+		if (DBL_OPERAND(0) == 0 && DBL_OPERAND(1) < 0)
+		{
+			return error(tr("division by zero"));
+		}
+		if (DBL_OPERAND(0) < 0 && DBL_OPERAND(1) != floor(DBL_OPERAND(1)))
+		{
+			return error(tr("invalid argument"));
+		}
+		DBL_RESULT = pow(DBL_OPERAND(0), DBL_OPERAND(1));
+		NEXT;
+	HANDLER(PowerI1_Code):
+		if (INT_OPERAND(0) == 0 && DBL_OPERAND(1) < 0)
+		{
+			return error(tr("division by zero"));
+		}
+		if (INT_OPERAND(0) < 0 && DBL_OPERAND(1) != floor(DBL_OPERAND(1)))
+		{
+			return error(tr("invalid argument"));
+		}
+		DBL_RESULT = pow((double)INT_OPERAND(0), DBL_OPERAND(1));
+		NEXT;
+	HANDLER(PowerMul_Code):
+		if (DBL_OPERAND(0) == 0 && INT_OPERAND(1) < 0)
+		{
+			return error(tr("division by zero"));
+		}
+		DBL_RESULT = pow(DBL_OPERAND(0), INT_OPERAND(1));
+		NEXT;
+	HANDLER(PowerInt_Code):
+	{
+		if (INT_OPERAND(0) == 0 && INT_OPERAND(1) < 0)
+		{
+			return error(tr("division by zero"));
+		}
+		double result = pow((double)INT_OPERAND(0), INT_OPERAND(1));
+		if (INT_OPERAND(1) < 0)
+		{
+			// (only a value of 1 or -1 has an integer result)
+			result = result < 0 ? ceil(result) : floor(result);
+		}
+		if (!fitsInt(result))
+		{
+			return error(tr("overflow"));
+		}
+		INT_RESULT = (int)result;
+		NEXT;
+	}
+
+	HANDLER(Neg_Code):
+		DBL_RESULT = -DBL_OPERAND(0);
+		NEXT;
+	HANDLER(NegInt_Code):
+		if (!fitsInt(-(double)INT_OPERAND(0)))
+		{
+			return error(tr("overflow"));
+		}
+		INT_RESULT = -INT_OPERAND(0);
+		NEXT;
+
+	//------------------------
+	//  COMPARISON OPERATORS
+	//------------------------
+
+	COMPARE_HANDLERS(Eq, ==)
+	COMPARE_HANDLERS(Gt, >)
+	COMPARE_HANDLERS(GtEq, >=)
+	COMPARE_HANDLERS(Lt, <)
+	COMPARE_HANDLERS(LtEq, <=)
+	COMPARE_HANDLERS(NotEq, !=)
+
+	//---------------------
+	//  LOGICAL OPERATORS
+	//---------------------
+
+	HANDLER(And_Code):
+		INT_RESULT = INT_OPERAND(0) & INT_OPERAND(1);
+		NEXT;
+	HANDLER(Or_Code):
+		INT_RESULT = INT_OPERAND(0) | INT_OPERAND(1);
+		NEXT;
+	HANDLER(Not_Code):
+		INT_RESULT = ~INT_OPERAND(0);
+		NEXT;
+	HANDLER(Eqv_Code):
+		INT_RESULT = ~(INT_OPERAND(0) ^ INT_OPERAND(1));
+		NEXT;
+	HANDLER(Imp_Code):
+		INT_RESULT = ~INT_OPERAND(0) | INT_OPERAND(1);
+		NEXT;
+	HANDLER(Xor_Code):
+		INT_RESULT = INT_OPERAND(0) ^ INT_OPERAND(1);
+		NEXT;
+
+	//--------------------
+	//  STRING OPERATORS
+	//--------------------
+
+	// (appended in place when the result is the first operand)
+	HANDLER(CatStr_Code):
+		if (instruction->result == instruction->operand[0]
+			&& instruction->operand[0] != instruction->operand[1])
+		{
+			STR_RESULT.append(STR_OPERAND(1));
+			NEXT;
+		}
+		STR_RESULT = STR_OPERAND(0) + STR_OPERAND(1);
+		NEXT;
+
+	//-----------------------
+	//  NUMERIC FUNCTIONS
+	//-----------------------
+
+	HANDLER(Abs_Code):
+		DBL_RESULT = fabs(DBL_OPERAND(0));
+		NEXT;
+	HANDLER(AbsInt_Code):
+		if (INT_OPERAND(0) < 0 && !fitsInt(-(double)INT_OPERAND(0)))
+		{
+			return error(tr("overflow"));
+		}
+		INT_RESULT = INT_OPERAND(0) < 0 ? -INT_OPERAND(0) : INT_OPERAND(0);
+		NEXT;
+	HANDLER(Fix_Code):
+		DBL_RESULT = DBL_OPERAND(0) < 0 ? ceil(DBL_OPERAND(0))
+			: floor(DBL_OPERAND(0));
+		NEXT;
+	HANDLER(Frac_Code):
+		DBL_RESULT = DBL_OPERAND(0) - (DBL_OPERAND(0) < 0
+			? ceil(DBL_OPERAND(0)) : floor(DBL_OPERAND(0)));
+		NEXT;
+	HANDLER(Int_Code):
+		DBL_RESULT = floor(DBL_OPERAND(0));
+		NEXT;
+	HANDLER(Rnd_Code):
+		DBL_RESULT = random();
+		NEXT;
+	HANDLER(RndArg_Code):
+		// (random integer value from 1 to the argument)
+		if (DBL_OPERAND(0) < 1)
+		{
+			return error(tr("invalid argument"));
+		}
+		DBL_RESULT = floor(random() * floor(DBL_OPERAND(0))) + 1;
+		NEXT;
+	HANDLER(RndArgInt_Code):
+		if (INT_OPERAND(0) < 1)
+		{
+			return error(tr("invalid argument"));
+		}
+		INT_RESULT = (int)(random() * INT_OPERAND(0)) + 1;
+		NEXT;
+	HANDLER(Sgn_Code):
+		DBL_RESULT = DBL_OPERAND(0) > 0 ? 1 : DBL_OPERAND(0) < 0 ? -1 : 0;
+		NEXT;
+	HANDLER(SgnInt_Code):
+		INT_RESULT = INT_OPERAND(0) > 0 ? 1 : INT_OPERAND(0) < 0 ? -1 : 0;
+		NEXT;
+	HANDLER(Cint_Code):
+	HANDLER(CvtInt_Code):
+		if (!roundInt(DBL_OPERAND(0), INT_RESULT))
+		{
+			return error(tr("overflow"));
+		}
+		NEXT;
+	HANDLER(Cdbl_Code):
+	HANDLER(CvtDbl_Code):
+		DBL_RESULT = INT_OPERAND(0);
+		NEXT;
+	HANDLER(Sqr_Code):
+		if (DBL_OPERAND(0) < 0)
+		{
+			return error(tr("invalid argument"));
+		}
+		DBL_RESULT = sqrt(DBL_OPERAND(0));
+		NEXT;
+	HANDLER(Atn_Code):
+		DBL_RESULT = atan(DBL_OPERAND(0));
+		NEXT;
+	HANDLER(Cos_Code):
+		DBL_RESULT = cos(DBL_OPERAND(0));
+		NEXT;
+	HANDLER(Sin_Code):
+		DBL_RESULT = sin(DBL_OPERAND(0));
+		NEXT;
+	HANDLER(Tan_Code):
+		DBL_RESULT = tan(DBL_OPERAND(0));
+		NEXT;
+	HANDLER(Exp_Code):
+		DBL_RESULT = exp(DBL_OPERAND(0));
+		NEXT;
+	HANDLER(Log_Code):
+		if (DBL_OPERAND(0) <= 0)
+		{
+			return error(tr("invalid argument"));
+		}
+		DBL_RESULT = log(DBL_OPERAND(0));
+		NEXT;
+
+	//--------------------
+	//  STRING FUNCTIONS
+	//--------------------
+
+	HANDLER(Asc_Code):
+		if (STR_OPERAND(0).isEmpty())
+		{
+			return error(tr("invalid argument"));
+		}
+		INT_RESULT = STR_OPERAND(0).at(0).unicode();
+		NEXT;
+	HANDLER(Asc2_Code):
+		if (INT_OPERAND(1) < 1 || INT_OPERAND(1) > STR_OPERAND(0).length())
+		{
+			return error(tr("invalid argument"));
+		}
+		INT_RESULT = STR_OPERAND(0).at(INT_OPERAND(1) - 1).unicode();
+		NEXT;
+	HANDLER(Chr_Code):
+		if (INT_OPERAND(0) < 0 || INT_OPERAND(0) > 0xFFFF)
+		{
+			return error(tr("invalid argument"));
+		}
+		STR_RESULT = QString(QChar(INT_OPERAND(0)));
+		NEXT;
+	HANDLER(Instr2_Code):
+		INT_RESULT = STR_OPERAND(0).indexOf(STR_OPERAND(1)) + 1;
+		NEXT;
+	HANDLER(Instr3_Code):
+		if (INT_OPERAND(2) < 1)
+		{
+			return error(tr("invalid argument"));
+		}
+		INT_RESULT = STR_OPERAND(0).indexOf(STR_OPERAND(1),
+			INT_OPERAND(2) - 1) + 1;
+		NEXT;
+	HANDLER(Left_Code):
+		if (INT_OPERAND(1) < 0)
+		{
+			return error(tr("invalid argument"));
+		}
+		STR_RESULT = STR_OPERAND(0).left(INT_OPERAND(1));
+		NEXT;
+	HANDLER(Len_Code):
+		INT_RESULT = STR_OPERAND(0).length();
+		NEXT;
+	HANDLER(Mid2_Code):
+		if (INT_OPERAND(1) < 1)
+		{
+			return error(tr("invalid argument"));
+		}
+		STR_RESULT = STR_OPERAND(0).mid(INT_OPERAND(1) - 1);
+		NEXT;
+	HANDLER(Mid3_Code):
+		if (INT_OPERAND(1) < 1 || INT_OPERAND(2) < 0)
+		{
+			return error(tr("invalid argument"));
+		}
+		STR_RESULT = STR_OPERAND(0).mid(INT_OPERAND(1) - 1, INT_OPERAND(2));
+		NEXT;
+	HANDLER(Repeat_Code):
+		if (INT_OPERAND(1) < 0)
+		{
+			return error(tr("invalid argument"));
+		}
+		STR_RESULT = STR_OPERAND(0).repeated(INT_OPERAND(1));
+		NEXT;
+	HANDLER(Right_Code):
+		if (INT_OPERAND(1) < 0)
+		{
+			return error(tr("invalid argument"));
+		}
+		STR_RESULT = STR_OPERAND(0).right(INT_OPERAND(1));
+		NEXT;
+	HANDLER(Space_Code):
+		if (INT_OPERAND(0) < 0)
+		{
+			return error(tr("invalid argument"));
+		}
+		STR_RESULT = QString(INT_OPERAND(0), ' ');
+		NEXT;
+	HANDLER(Str_Code):
+		// (same as printed without the trailing space)
+		STR_RESULT = printNumberText(DBL_OPERAND(0));
+		STR_RESULT.chop(1);
+		NEXT;
+	HANDLER(StrInt_Code):
+		STR_RESULT = printNumberText(INT_OPERAND(0));
+		STR_RESULT.chop(1);
+		NEXT;
+	HANDLER(Val_Code):
+	{
+		bool ok;
+		double value = STR_OPERAND(0).trimmed().toDouble(&ok);
+		DBL_RESULT = ok ? value : 0;
+		NEXT;
+	}
+
+	//-----------------
+	//  ASSIGNMENTS
+	//-----------------
+
+	// (the list assignments are lowered to an instruction for each
+	// reference, the keep assignment is the same as the assignment)
+	HANDLER(Assign_Code):
+	HANDLER(AssignList_Code):
+		DBL_RESULT = DBL_OPERAND(0);
+		NEXT;
+	HANDLER(AssignInt_Code):
+	HANDLER(AssignListInt_Code):
+		INT_RESULT = INT_OPERAND(0);
+		NEXT;
+	HANDLER(AssignStr_Code):
+	HANDLER(AssignListStr_Code):
+	HANDLER(AssignKeepStr_Code):
+		STR_RESULT = STR_OPERAND(0);
+		NEXT;
+
+	// (the result is the string variable, the first operand is the value,
+	// the others are the arguments of the sub-string)
+	HANDLER(AssignLeft_Code):
+	HANDLER(AssignKeepLeft_Code):
+		if (!assignSubStr(&STR_RESULT, 0, INT_OPERAND(1), STR_OPERAND(0)))
+		{
+			return false;
+		}
+		NEXT;
+	HANDLER(AssignMid2_Code):
+	HANDLER(AssignKeepMid2_Code):
+		if (!assignSubStr(&STR_RESULT, INT_OPERAND(1) - 1,
+			STR_RESULT.length(), STR_OPERAND(0)))
+		{
+			return false;
+		}
+		NEXT;
+	HANDLER(AssignMid3_Code):
+	HANDLER(AssignKeepMid3_Code):
+		if (!assignSubStr(&STR_RESULT, INT_OPERAND(1) - 1, INT_OPERAND(2),
+			STR_OPERAND(0)))
+		{
+			return false;
+		}
+		NEXT;
+	HANDLER(AssignRight_Code):
+	HANDLER(AssignKeepRight_Code):
+	{
+		int count = qMin(INT_OPERAND(1), STR_RESULT.length());
+		if (!assignSubStr(&STR_RESULT, STR_RESULT.length() - count, count,
+			STR_OPERAND(0)))
+		{
+			return false;
+		}
+		NEXT;
+	}
+
+	//-----------
+	//  PRINT
+	//-----------
+
+	HANDLER(PrintDbl_Code):
+		print(printNumberText(DBL_OPERAND(0)));
+		NEXT;
+	HANDLER(PrintInt_Code):
+		print(printNumberText(INT_OPERAND(0)));
+		NEXT;
+	HANDLER(PrintStr_Code):
+	HANDLER(PrintConst_Code):
+		print(STR_OPERAND(0));
+		NEXT;
+	HANDLER(Tab_Code):
+		// (move to the column of the argument, on the next line if the
+		// column has already been passed)
+		if (INT_OPERAND(0) < 1)
+		{
+			return error(tr("invalid argument"));
+		}
+		if (m_column >= INT_OPERAND(0))
+		{
+			printNewLine();
+		}
+		print(QString(INT_OPERAND(0) - 1 - m_column, ' '));
+		NEXT;
+	HANDLER(Spc_Code):
+		if (INT_OPERAND(0) > 0)
+		{
+			print(QString(INT_OPERAND(0), ' '));
+		}
+		NEXT;
+	HANDLER(Comma_Code):
+		// (move to the beginning of the next print zone)
+		print(QString(PrintZoneWidth - m_column % PrintZoneWidth, ' '));
+		NEXT;
+	HANDLER(Print_Code):
+		printNewLine();
+		NEXT;
+
+	//-----------
+	//  INPUT
+	//-----------
+
+	// (the first operand is the prompt, the second operand is the data
+	// types of the values, the third operand is the question mark of the
+	// question mark option)
+	HANDLER(InputBegin_Code):
+	HANDLER(InputBeginStr_Code):
+	{
+		// (the prompt is in its own block, see Runner::runCode)
+		{
+			QString prompt = STR_OPERAND(0);
+			if (instruction->operand[2] != NULL)
+			{
+				prompt.append(STR_OPERAND(2));
+			}
+			const DataType *types = (const DataType *)instruction->operand[1];
+			if (!input(prompt, types, types + instruction->count))
+			{
+				return false;
+			}
+		}
+		NEXT;
+	}
+
+	// (the count is the index of the value of the data type)
+	HANDLER(InputAssign_Code):
+		DBL_RESULT = m_inputDbl.at(instruction->count);
+		NEXT;
+	HANDLER(InputAssignInt_Code):
+		INT_RESULT = m_inputInt.at(instruction->count);
+		NEXT;
+	HANDLER(InputAssignStr_Code):
+		STR_RESULT = m_inputStr.at(instruction->count);
+		NEXT;
+}
+
+
+// end: registerrunner.cpp
@@ -0,0 +1,100 @@
+// vim:ts=4:sw=4:
+//
+//	Interactive BASIC Compiler Project
+//	File: registerrunner.h - register runner class header file
+//	Copyright (C) 2013  Thunder422
+//
+//	This program is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	This program is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU General Public License for more details.
+//
+//	For a copy of the GNU General Public License,
+//	see <http://www.gnu.org/licenses/>.
+//
+//
+//	Change History:
+//
+//	2013-11-09	initial version
+
+#ifndef REGISTERRUNNER_H
+#define REGISTERRUNNER_H
+
+#include <QStack>
+#include <QString>
+#include <QVector>
+
+#include "runner.h"
+
+
+// class for running the register code lowered from the program code of a
+// program snapshot (an alternative to running the program code directly)
+//
+//   - before the program is run, the reverse polish notation code of each
+//     line is lowered to three address instructions, each with a result
+//     and up to three operands, so an instruction takes its operands and
+//     stores its result directly instead of through the stacks
+//   - the operands and results are pointers to the values they refer to
+//     (variables, constants or registers), which are resolved when the code
+//     is lowered, so the handlers do not need to decode the operands
+//   - operand codes (constants, variables and references) do not become
+//     instructions, they become the operands of the instructions using them
+//   - the registers hold the intermediate values of a line, a register for
+//     each item of the stacks of the program code (the stacks of the runner
+//     are used for the registers), so a value is in the register of the
+//     stack item it would have been pushed to
+//   - the result of the instruction producing the value of an assignment is
+//     stored directly into the variable assigned (the assignment is not an
+//     instruction)
+//   - the instructions are dispatched the same as the program code (see
+//     Runner), the code of the instruction selects its handler
+
+class RegisterRunner : public Runner
+{
+public:
+	explicit RegisterRunner(const ProgramSnapshot &program);
+
+	int instructionCount(int *programCount);
+
+protected:
+	bool check(void);
+	bool runLine(int lineIndex);
+
+private:
+	struct Instruction
+	{
+		Code code;						// code of instruction (its handler)
+		int count;						// number of input values or index
+		void *result;					// result of instruction
+		const void *operand[3];			// operands of instruction
+	};
+
+	void lower(void);
+	void lowerLine(int lineIndex);
+	void *registerOperand(DataType dataType, int index);
+	bool runCode(const Instruction *instruction, const Instruction *end);
+
+	QVector<Instruction> m_code;		// instructions of the program
+	QVector<int> m_lineBegin;			// first instruction of each line
+
+	// values of operands that are not held by the program
+	QVector<double> m_immediate;		// values of immediate constants
+	QVector<int> m_immediateInt;
+	QVector<QString> m_constStr;		// values of string constants
+	QVector<QString> m_printConst;		// values of print constants
+	QVector<DataType> m_inputType;		// data types of input statements
+	QString m_inputPrompt;				// default prompt of input statements
+
+	// stacks used while lowering a line (see lowerLine)
+	QStack<const void *> m_lowerStack[numberof_DataType];
+	QStack<void *> m_lowerRefStack;
+	QVector<DataType> m_lowerInputType;
+};
+
+
+#endif  // REGISTERRUNNER_H
@@ -37,11 +37,13 @@ rem    be answered No for batch to continue - comp has no option to not
 rem    ask this question)
 rem
 
-del parser*.txt expression*.txt translator*.txt encoder*.txt
-for %%i in (test/parser*.dat test/expression*.dat test/translator*.dat test/encoder*.dat) do (
+del parser*.txt expression*.txt translator*.txt encoder*.txt recreator*.txt runner*.txt
+for %%i in (test/parser*.dat test/expression*.dat test/translator*.dat test/encoder*.dat test/recreator*.dat test/runner*.dat) do (
 	ibcp -t test\%%i >%%~ni.txt
 )
 comp test\parser*.txt parser*.txt
 comp test\expression*.txt expression*.txt
 comp test\translator*.txt translator*.txt
 comp test\encoder*.txt encoder*.txt
+comp test\recreator*.txt recreator*.txt
+comp test\runner*.txt runner*.txt
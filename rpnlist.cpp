@@ -172,4 +172,201 @@ bool RpnList::setCodeSize(Table &table, Token *&token)
 }
 
 
+// function to combine chains of string concatenations into single codes
+//
+//   - a concatenation whose first operand is a concatenation is combined
+//     with it into a single code with the number of strings as its operand
+//   - concatenations marked with unnecessary parentheses are not combined
+//     so the parentheses can be recreated
+//   - a concatenation of multiple strings only allocates its result once
+
+void RpnList::combineConcatenations(Table &table)
+{
+	for (int i = 0; i < count(); i++)
+	{
+		Token *token = at(i)->token();
+		if (!token->isCode(CatStr_Code))
+		{
+			continue;
+		}
+
+		// first operand ends just before the start of the second operand
+		int first = operandStart(table, i - 1) - 1;
+		if (first < 0)
+		{
+			continue;
+		}
+		Token *firstToken = at(first)->token();
+		if (firstToken->hasSubCode(Paren_SubCode))
+		{
+			continue;
+		}
+		if (firstToken->isCode(CatStr_Code))
+		{
+			token->setValue(3);
+		}
+		else if (firstToken->isCode(CatStrs_Code))
+		{
+			token->setValue(firstToken->valueInt() + 1);
+		}
+		else
+		{
+			continue;
+		}
+		token->setCode(CatStrs_Code);
+
+		delete takeAt(first);  // first concatenation no longer needed
+		i--;
+	}
+}
+
+
+// function to find the start of the operand that ends at an index
+//
+//   - returns -1 if the start could not be determined
+
+int RpnList::operandStart(Table &table, int index)
+{
+	int needed = 1;  // number of operands still needed
+	for (; index >= 0; index--)
+	{
+		Token *token = at(index)->token();
+		if (token->isCode(CloseParen_Code))
+		{
+			continue;  // dummy token for unnecessary parentheses
+		}
+		needed--;
+		switch (token->type())
+		{
+		case Operator_TokenType:
+		case IntFuncN_TokenType:
+		case IntFuncP_TokenType:
+			if (token->isCode(CatStrs_Code))
+			{
+				needed += token->valueInt();
+			}
+			else if (table.hasFlag(token, Hidden_Flag))
+			{
+				needed++;  // conversion code
+			}
+			else
+			{
+				needed += table.operandCount(token);
+			}
+			break;
+
+		case Constant_TokenType:
+		case NoParen_TokenType:
+			break;
+
+		default:
+			return -1;  // array or function (not supported yet)
+		}
+		if (needed == 0)
+		{
+			return index;
+		}
+	}
+	return -1;
+}
+
+
+// function to combine runs of constant print items into single codes
+//
+//   - a run is two or more constants separated by semicolons, whose
+//     output does not depend on the current column (commas break runs)
+//   - the text of the items is kept in the combined token for recreation,
+//     the printed text is built from the items when the line is encoded
+//   - the combined token keeps the constant token type so that lines with
+//     different items will not compare as equal
+
+void RpnList::combinePrintConstants(void)
+{
+	for (int i = 0; i < count(); i++)
+	{
+		int end = i;
+		QString items;
+		while (isPrintConstant(end))
+		{
+			if (end > i)
+			{
+				items += ';';
+			}
+			Token *token = at(end)->token();
+			if (token->isCode(ConstStr_Code))
+			{
+				QString string = token->string();
+				items.append('"').append(string.replace('"', "\"\""))
+					.append('"');
+			}
+			else  // numeric constant
+			{
+				items += token->string();
+			}
+			end += 2;  // skip constant and print code
+		}
+		if (end - i < 4)  // not at least two items?
+		{
+			continue;
+		}
+
+		Token *token = at(i)->token();
+		token->setCode(PrintConst_Code);
+		token->setString(items);
+		while (--end > i)
+		{
+			delete takeAt(i + 1);  // remove other items of run
+		}
+	}
+}
+
+
+// function to check if item at index is a constant being printed
+
+bool RpnList::isPrintConstant(int index)
+{
+	if (index + 1 >= count())
+	{
+		return false;
+	}
+	Token *token = at(index)->token();
+	if (!token->isType(Constant_TokenType) || token->hasSubCode(Paren_SubCode))
+	{
+		return false;
+	}
+	Token *printToken = at(index + 1)->token();
+	return printToken->isCode(PrintDbl_Code) || printToken->isCode(PrintInt_Code)
+		|| printToken->isCode(PrintStr_Code);
+}
+
+
+// function to return the memory of the list and its items (in bytes,
+// estimated), not including the tokens of the items
+
+int RpnList::memory(void)
+{
+	int memory = sizeof(RpnList) - sizeof(QString)
+		+ stringMemory(m_errorMessage) + count() * sizeof(RpnItem *);
+	for (int i = 0; i < count(); i++)
+	{
+		memory += sizeof(RpnItem) + at(i)->attachedCount() * sizeof(RpnItem *);
+	}
+	return memory;
+}
+
+
+// function to return the memory of the tokens of the items of the list
+// (in bytes, estimated)
+
+int RpnList::tokenMemory(void)
+{
+	int memory = 0;
+	for (int i = 0; i < count(); i++)
+	{
+		memory += at(i)->token()->memory();
+	}
+	return memory;
+}
+
+
 // end: rpnlist.cpp
@@ -120,6 +120,10 @@ public:
 		return m_codeSize;
 	}
 	bool setCodeSize(Table &table, Token *&token);
+	void combineConcatenations(Table &table);
+	void combinePrintConstants(void);
+	int memory(void);
+	int tokenMemory(void);
 
 	void setError(Token *errorToken)
 	{
@@ -149,6 +153,9 @@ public:
 	}
 
 private:
+	int operandStart(Table &table, int index);
+	bool isPrintConstant(int index);
+
 	int m_codeSize;					// size of code required for list
 	int m_errorColumn;				// column of error that occurred
 	int m_errorLength;				// length of error that occurred
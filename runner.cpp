@@ -0,0 +1,1200 @@
+// vim:ts=4:sw=4:
+//
+//	Interactive BASIC Compiler Project
+//	File: runner.cpp - runner class source file
+//	Copyright (C) 2013  Thunder422
+//
+//	This program is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	This program is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU General Public License for more details.
+//
+//	For a copy of the GNU General Public License,
+//	see <http://www.gnu.org/licenses/>.
+//
+//
+//	Change History:
+//
+//	2013-11-02	initial version
+
+#include <QTextStream>
+
+#include "runner.h"
+#include "table.h"
+#include "basic/basic.h"
+
+
+Runner::Runner(const ProgramSnapshot &program) :
+	m_table(Table::instance()),
+	m_program(program),
+	m_lineIndex(0),
+	m_constIndex(NULL),
+	m_constValue(NULL),
+	m_constValueInt(NULL),
+	m_column(0),
+	m_output(NULL),
+	m_input(NULL),
+	m_seed(2463534242u)
+{
+
+}
+
+
+// function to run the program (returns false if a run error occurred)
+//
+//   - the program ends after the last line or at an END statement
+//   - values are input from the input stream, the prompts of input
+//     statements and the output of print statements are output to the
+//     output stream
+
+bool Runner::run(QTextStream &output, QTextStream &input)
+{
+	m_errorMessage.clear();
+	m_output = &output;
+	m_input = &input;
+	m_column = 0;
+
+	if (check())
+	{
+		for (m_lineIndex = 0; m_lineIndex < m_program.lineCount();
+			m_lineIndex++)
+		{
+			if (!runLine(m_lineIndex))
+			{
+				break;  // end of program or run error
+			}
+		}
+	}
+	output.flush();
+	return m_errorMessage.isEmpty();
+}
+
+
+// function to check the program and allocate the values and stacks
+//
+//   - the program can't be run if any line has an error, every word of
+//     the code must have a valid code (the word after a wide operand
+//     instruction is not an instruction)
+//   - the stacks are allocated for the largest line since each
+//     instruction pushes at most one item
+
+bool Runner::check(void)
+{
+	int maxSize = 0;
+	for (m_lineIndex = 0; m_lineIndex < m_program.lineCount(); m_lineIndex++)
+	{
+		if (m_program.lineHasError(m_lineIndex))
+		{
+			return error(tr("line has an error"));
+		}
+		const ProgramWord *line = m_program.lineCode(m_lineIndex);
+		int size = m_program.lineSize(m_lineIndex);
+		for (int i = 0; i < size; i++)
+		{
+			if (line[i].instructionCode() >= sizeof_Code
+				|| (line[i].hasWideOperand() && ++i >= size))
+			{
+				return error(tr("invalid code"));
+			}
+		}
+		maxSize = qMax(maxSize, size);
+	}
+	allocate(maxSize);
+	return true;
+}
+
+
+// function to allocate the values and stacks (for the largest line size)
+void Runner::allocate(int maxSize)
+{
+	const ConstNumDictionary &constNum = m_program.constNumDictionary();
+	m_constIndex = constNum.valueIndexes();
+	m_constValue = constNum.values();
+	m_constValueInt = constNum.valueInts();
+
+	m_varDbl = QVector<double>(m_program.varDblDictionary().count(), 0.0);
+	m_varInt = QVector<int>(m_program.varIntDictionary().count(), 0);
+	m_varStr = QVector<QString>(m_program.varStrDictionary().count(),
+		QString(""));
+
+	m_dblStack.resize(maxSize);
+	m_intStack.resize(maxSize);
+	m_strStack.resize(maxSize);
+	m_refStack.resize(maxSize);
+	m_typeStack.resize(maxSize);
+}
+
+
+// function to set a run error at the current line (always returns false)
+bool Runner::error(const QString &message)
+{
+	m_errorMessage = tr("Error at line %1: %2").arg(m_lineIndex + 1)
+		.arg(message);
+	return false;
+}
+
+
+//=====================
+//  LINE RUN FUNCTIONS
+//=====================
+
+// macros for the dispatch of the handlers
+//
+//   - HANDLER gives the label of the handler of a code
+//   - NEXT goes to the next instruction (skipping a wide operand word) and
+//     dispatches it, the line is done when the end of the line is reached
+//   - DISPATCH jumps directly to the handler of the current instruction
+//     when the compiler supports label addresses, otherwise to the switch
+//     statement that jumps to the handler
+
+#define HANDLER(code)  code##_Handler
+
+#ifdef __GNUC__
+#define DISPATCH  goto *dispatchTable[word->instructionCode()]
+#else
+#define DISPATCH  goto dispatch
+#endif
+
+#define NEXT \
+	do { \
+		word += word->hasWideOperand() ? 2 : 1; \
+		if (word == end) \
+		{ \
+			return true; \
+		} \
+		DISPATCH; \
+	} while (0)
+
+
+// macro for the handlers of the forms of a comparison operator
+//
+//   - the result is -1 for true and 0 for false (integer)
+//   - the I1 form has an integer first operand, the I2 form has an integer
+//     second operand (the other operand is a double)
+
+#define COMPARE_HANDLERS(name, op) \
+	HANDLER(name##_Code): \
+		dblTop -= 2; \
+		*intTop++ = -(dblTop[0] op dblTop[1]); \
+		NEXT; \
+	HANDLER(name##I1_Code): \
+		--dblTop; \
+		intTop[-1] = -(intTop[-1] op *dblTop); \
+		NEXT; \
+	HANDLER(name##I2_Code): \
+		--dblTop; \
+		intTop[-1] = -(*dblTop op intTop[-1]); \
+		NEXT; \
+	HANDLER(name##Int_Code): \
+		--intTop; \
+		intTop[-1] = -(intTop[-1] op *intTop); \
+		NEXT; \
+	HANDLER(name##Str_Code): \
+		strTop -= 2; \
+		*intTop++ = -(QString::compare(strTop[0], strTop[1]) op 0); \
+		NEXT;
+
+
+// function to run a line of the program (returns false to stop the program)
+bool Runner::runLine(int lineIndex)
+{
+	const ProgramWord *line = m_program.lineCode(lineIndex);
+	return runCode(line, line + m_program.lineSize(lineIndex));
+}
+
+
+// function to run the code of a line (returns false to stop the program)
+//
+//   - the stacks only contain the items of the current statement, so each
+//     line starts with empty stacks
+//   - the stack pointers point to the next free item of each stack
+//   - each handler is in its own block so that jumps to the handlers do not
+//     skip the initialization of any variables of the other handlers
+
+bool Runner::runCode(const ProgramWord *word, const ProgramWord *end)
+{
+#ifdef __GNUC__
+	static const void *const dispatchTable[sizeof_Code] = {
+#define RunHandler(code)  &&HANDLER(code),
+#include "autohandlers.h"
+#undef RunHandler
+	};
+#endif
+
+	double *dblTop = m_dblStack.data();
+	int *intTop = m_intStack.data();
+	QString *strTop = m_strStack.data();
+	void **refBase = m_refStack.data();
+	void **refTop = refBase;
+	DataType *typeBase = m_typeStack.data();
+	DataType *typeTop = typeBase;
+
+	double *varDbl = m_varDbl.data();
+	int *varInt = m_varInt.data();
+	QString *varStr = m_varStr.data();
+
+	// values of the current input statement
+	const double *inputDbl = NULL;
+	const int *inputInt = NULL;
+	const QString *inputStr = NULL;
+
+	if (word == end)
+	{
+		return true;  // blank line
+	}
+	DISPATCH;
+
+#ifndef __GNUC__
+dispatch:
+	switch (word->instructionCode())
+	{
+#define RunHandler(code)  case code: goto HANDLER(code);
+#include "autohandlers.h"
+#undef RunHandler
+	}
+#endif
+
+	// codes that are not program instructions (or not used)
+	HANDLER(Null_Code):
+	HANDLER(BegPlainWord_Code):
+	HANDLER(EndPlainWord_Code):
+	HANDLER(BegParenWord_Code):
+	HANDLER(EndParenWord_Code):
+	HANDLER(BegDataTypeWord_Code):
+	HANDLER(EndDataTypeWord_Code):
+	HANDLER(BegSymbol_Code):
+	HANDLER(EndSymbol_Code):
+	HANDLER(OpenParen_Code):
+		return error(tr("invalid code"));
+
+	// commands not implemented yet
+	HANDLER(Dim_Code):
+	HANDLER(Def_Code):
+	HANDLER(If_Code):
+	HANDLER(Then_Code):
+	HANDLER(Else_Code):
+	HANDLER(EndIf_Code):
+	HANDLER(For_Code):
+	HANDLER(To_Code):
+	HANDLER(Step_Code):
+	HANDLER(Next_Code):
+	HANDLER(Do_Code):
+	HANDLER(DoWhile_Code):
+	HANDLER(DoUntil_Code):
+	HANDLER(While_Code):
+	HANDLER(Until_Code):
+	HANDLER(Loop_Code):
+	HANDLER(LoopWhile_Code):
+	HANDLER(LoopUntil_Code):
+		return error(tr("%1 not implemented")
+			.arg(m_table.name(word->instructionCode())));
+
+	// codes with nothing to run (the remark codes, the codes at the end of
+	// statements without a command and unnecessary parentheses entered)
+	HANDLER(Let_Code):
+	HANDLER(Rem_Code):
+	HANDLER(RemOp_Code):
+	HANDLER(CloseParen_Code):
+	HANDLER(Colon_Code):
+	HANDLER(EOL_Code):
+		NEXT;
+
+	HANDLER(End_Code):
+		return false;  // end of program (no error)
+
+	//-------------
+	//  OPERANDS
+	//-------------
+
+	HANDLER(Const_Code):
+		*dblTop++ = m_constValue[m_constIndex[word->operand()]];
+		NEXT;
+	HANDLER(ConstInt_Code):
+		*intTop++ = m_constValueInt[m_constIndex[word->operand()]];
+		NEXT;
+	HANDLER(ConstStr_Code):
+		*strTop++ = m_program.constStrDictionary().value(word->operand());
+		NEXT;
+	HANDLER(ConstImm_Code):
+		*dblTop++ = word->operand();
+		NEXT;
+	HANDLER(ConstIntImm_Code):
+		*intTop++ = word->operand();
+		NEXT;
+
+	HANDLER(Var_Code):
+		*dblTop++ = varDbl[word->operand()];
+		NEXT;
+	HANDLER(VarInt_Code):
+		*intTop++ = varInt[word->operand()];
+		NEXT;
+	HANDLER(VarStr_Code):
+		*strTop++ = varStr[word->operand()];
+		NEXT;
+	HANDLER(VarRef_Code):
+		*refTop++ = &varDbl[word->operand()];
+		NEXT;
+	HANDLER(VarRefInt_Code):
+		*refTop++ = &varInt[word->operand()];
+		NEXT;
+	HANDLER(VarRefStr_Code):
+		*refTop++ = &varStr[word->operand()];
+		NEXT;
+
+	//-----------------------
+	//  NUMERIC OPERATORS
+	//-----------------------
+
+	HANDLER(Add_Code):
+		--dblTop;
+		dblTop[-1] += *dblTop;
+		NEXT;
+	HANDLER(AddI1_Code):
+		dblTop[-1] = *--intTop + dblTop[-1];
+		NEXT;
+	HANDLER(AddI2_Code):
+		dblTop[-1] += *--intTop;
+		NEXT;
+	HANDLER(AddInt_Code):
+	{
+		--intTop;
+		double result = (double)intTop[-1] + *intTop;
+		if (!fitsInt(result))
+		{
+			return error(tr("overflow"));
+		}
+		intTop[-1] = (int)result;
+		NEXT;
+	}
+
+	HANDLER(Sub_Code):
+		--dblTop;
+		dblTop[-1] -= *dblTop;
+		NEXT;
+	HANDLER(SubI1_Code):
+		dblTop[-1] = *--intTop - dblTop[-1];
+		NEXT;
+	HANDLER(SubI2_Code):
+		dblTop[-1] -= *--intTop;
+		NEXT;
+	HANDLER(SubInt_Code):
+	{
+		--intTop;
+		double result = (double)intTop[-1] - *intTop;
+		if (!fitsInt(result))
+		{
+			return error(tr("overflow"));
+		}
+		intTop[-1] = (int)result;
+		NEXT;
+	}
+
+	HANDLER(Mul_Code):
+		--dblTop;
+		dblTop[-1] *= *dblTop;
+		NEXT;
+	HANDLER(MulI1_Code):
+		dblTop[-1] = *--intTop * dblTop[-1];
+		NEXT;
+	HANDLER(MulI2_Code):
+		dblTop[-1] *= *--intTop;
+		NEXT;
+	HANDLER(MulInt_Code):
+	{
+		--intTop;
+		double result = (double)intTop[-1] * *intTop;
+		if (!fitsInt(result))
+		{
+			return error(tr("overflow"));
+		}
+		intTop[-1] = (int)result;
+		NEXT;
+	}
+
+	HANDLER(Div_Code):
+		if (*--dblTop == 0)
+		{
+			return error(tr("division by zero"));
+		}
+		dblTop[-1] /= *dblTop;
+		NEXT;
+	HANDLER(DivI1_Code):
+		if (dblTop[-1] == 0)
+		{
+			return error(tr("division by zero"));
+		}
+		dblTop[-1] = *--intTop / dblTop[-1];
+		NEXT;
+	HANDLER(DivI2_Code):
+		if (*--intTop == 0)
+		{
+			return error(tr("division by zero"));
+		}
+		dblTop[-1] /= *intTop;
+		NEXT;
+	HANDLER(DivInt_Code):
+		if (*--intTop == 0)
+		{
+			return error(tr("division by zero"));
+		}
+		if (*intTop == -1)
+		{
+			if (!fitsInt(-(double)intTop[-1]))
+			{
+				return error(tr("overflow"));
+			}
+			intTop[-1] = -intTop[-1];
+			NEXT;
+		}
+		intTop[-1] /= *intTop;
+		NEXT;
+	HANDLER(IntDiv_Code):
+	{
+		if (*--dblTop == 0)
+		{
+			return error(tr("division by zero"));
+		}
+		double result = dblTop[-1] / *dblTop;
+		result = result < 0 ? ceil(result) : floor(result);
+		if (!fitsInt(result))
+		{
+			return error(tr("overflow"));
+		}
+		--dblTop;
+		*intTop++ = (int)result;
+		NEXT;
+	}
+
+	HANDLER(Mod_Code):
+		if (*--dblTop == 0)
+		{
+			return error(tr("division by zero"));
+		}
+		dblTop[-1] = fmod(dblTop[-1], *dblTop);
+		NEXT;
+	HANDLER(ModI1_Code):
+		if (dblTop[-1] == 0)
+		{
+			return error(tr("division by zero"));
+		}
+		dblTop[-1] = fmod(*--intTop, dblTop[-1]);
+		NEXT;
+	HANDLER(ModI2_Code):
+		if (*--intTop == 0)
+		{
+			return error(tr("division by zero"));
+		}
+		dblTop[-1] = fmod(dblTop[-1], *intTop);
+		NEXT;
+	HANDLER(ModInt_Code):
+		if (*--intTop == 0)
+		{
+			return error(tr("division by zero"));
+		}
+		intTop[-1] = *intTop == -1 ? 0 : intTop[-1] % *intTop;
+		NEXT;
+
+	HANDLER(Power_Code):
+		--dblTop;
+		if (dblTop[-1] == 0 && *dblTop < 0)
+		{
+			return error(tr("division by zero"));
+		}
+		if (dblTop[-1] < 0 && *dblTop != floor(*dblTop))
+		{
+			return error(tr("invalid argument"));
+		}
+		dblTop[-1] = pow(dblTop[-1], *dblTop);
+		NEXT;
+	HANDLER(PowerI1_Code):
+		--intTop;
+		if (*intTop == 0 && dblTop[-1] < 0)
+		{
+			return error(tr("division by zero"));
+		}
+		if (*intTop < 0 && dblTop[-1] != floor(dblTop[-1]))
+		{
+			return error(tr("invalid argument"));
+		}
+		dblTop[-1] = pow((double)*intTop, dblTop[-1]);
+		NEXT;
+	HANDLER(PowerMul_Code):
+		--intTop;
+		if (dblTop[-1] == 0 && *intTop < 0)
+		{
+			return error(tr("division by zero"));
+		}
+		dblTop[-1] = pow(dblTop[-1], *intTop);
+		NEXT;
+	HANDLER(PowerInt_Code):
+	{
+		--intTop;
+		if (intTop[-1] == 0 && *intTop < 0)
+		{
+			return error(tr("division by zero"));
+		}
+		double result = pow((double)intTop[-1], *intTop);
+		if (*intTop < 0)
+		{
+			// (only a value of 1 or -1 has an integer result)
+			result = result < 0 ? ceil(result) : floor(result);
+		}
+		if (!fitsInt(result))
+		{
+			return error(tr("overflow"));
+		}
+		intTop[-1] = (int)result;
+		NEXT;
+	}
+
+	HANDLER(Neg_Code):
+		dblTop[-1] = -dblTop[-1];
+		NEXT;
+	HANDLER(NegInt_Code):
+		if (!fitsInt(-(double)intTop[-1]))
+		{
+			return error(tr("overflow"));
+		}
+		intTop[-1] = -intTop[-1];
+		NEXT;
+
+	//------------------------
+	//  COMPARISON OPERATORS
+	//------------------------
+
+	COMPARE_HANDLERS(Eq, ==)
+	COMPARE_HANDLERS(Gt, >)
+	COMPARE_HANDLERS(GtEq, >=)
+	COMPARE_HANDLERS(Lt, <)
+	COMPARE_HANDLERS(LtEq, <=)
+	COMPARE_HANDLERS(NotEq, !=)
+
+	//---------------------
+	//  LOGICAL OPERATORS
+	//---------------------
+
+	HANDLER(And_Code):
+		--intTop;
+		intTop[-1] &= *intTop;
+		NEXT;
+	HANDLER(Or_Code):
+		--intTop;
+		intTop[-1] |= *intTop;
+		NEXT;
+	HANDLER(Not_Code):
+		intTop[-1] = ~intTop[-1];
+		NEXT;
+	HANDLER(Eqv_Code):
+		--intTop;
+		intTop[-1] = ~(intTop[-1] ^ *intTop);
+		NEXT;
+	HANDLER(Imp_Code):
+		--intTop;
+		intTop[-1] = ~intTop[-1] | *intTop;
+		NEXT;
+	HANDLER(Xor_Code):
+		--intTop;
+		intTop[-1] ^= *intTop;
+		NEXT;
+
+	//--------------------
+	//  STRING OPERATORS
+	//--------------------
+
+	HANDLER(CatStr_Code):
+		--strTop;
+		strTop[-1].append(*strTop);
+		NEXT;
+	HANDLER(CatStrs_Code):
+	{
+		// (the operand is the number of strings concatenated)
+		int count = word->operand();
+		strTop -= count;
+		for (int i = 1; i < count; i++)
+		{
+			strTop[0].append(strTop[i]);
+		}
+		strTop++;
+		NEXT;
+	}
+
+	//-----------------------
+	//  NUMERIC FUNCTIONS
+	//-----------------------
+
+	HANDLER(Abs_Code):
+		dblTop[-1] = fabs(dblTop[-1]);
+		NEXT;
+	HANDLER(AbsInt_Code):
+		if (intTop[-1] < 0)
+		{
+			if (!fitsInt(-(double)intTop[-1]))
+			{
+				return error(tr("overflow"));
+			}
+			intTop[-1] = -intTop[-1];
+		}
+		NEXT;
+	HANDLER(Fix_Code):
+		dblTop[-1] = dblTop[-1] < 0 ? ceil(dblTop[-1]) : floor(dblTop[-1]);
+		NEXT;
+	HANDLER(Frac_Code):
+		dblTop[-1] -= dblTop[-1] < 0 ? ceil(dblTop[-1]) : floor(dblTop[-1]);
+		NEXT;
+	HANDLER(Int_Code):
+		dblTop[-1] = floor(dblTop[-1]);
+		NEXT;
+	HANDLER(Rnd_Code):
+		*dblTop++ = random();
+		NEXT;
+	HANDLER(RndArg_Code):
+		// (random integer value from 1 to the argument)
+		if (dblTop[-1] < 1)
+		{
+			return error(tr("invalid argument"));
+		}
+		dblTop[-1] = floor(random() * floor(dblTop[-1])) + 1;
+		NEXT;
+	HANDLER(RndArgInt_Code):
+		if (intTop[-1] < 1)
+		{
+			return error(tr("invalid argument"));
+		}
+		intTop[-1] = (int)(random() * intTop[-1]) + 1;
+		NEXT;
+	HANDLER(Sgn_Code):
+		dblTop[-1] = dblTop[-1] > 0 ? 1 : dblTop[-1] < 0 ? -1 : 0;
+		NEXT;
+	HANDLER(SgnInt_Code):
+		intTop[-1] = intTop[-1] > 0 ? 1 : intTop[-1] < 0 ? -1 : 0;
+		NEXT;
+	HANDLER(Cint_Code):
+	HANDLER(CvtInt_Code):
+		if (!roundInt(*--dblTop, *intTop++))
+		{
+			return error(tr("overflow"));
+		}
+		NEXT;
+	HANDLER(Cdbl_Code):
+	HANDLER(CvtDbl_Code):
+		*dblTop++ = *--intTop;
+		NEXT;
+	HANDLER(Sqr_Code):
+		if (dblTop[-1] < 0)
+		{
+			return error(tr("invalid argument"));
+		}
+		dblTop[-1] = sqrt(dblTop[-1]);
+		NEXT;
+	HANDLER(Atn_Code):
+		dblTop[-1] = atan(dblTop[-1]);
+		NEXT;
+	HANDLER(Cos_Code):
+		dblTop[-1] = cos(dblTop[-1]);
+		NEXT;
+	HANDLER(Sin_Code):
+		dblTop[-1] = sin(dblTop[-1]);
+		NEXT;
+	HANDLER(Tan_Code):
+		dblTop[-1] = tan(dblTop[-1]);
+		NEXT;
+	HANDLER(Exp_Code):
+		dblTop[-1] = exp(dblTop[-1]);
+		NEXT;
+	HANDLER(Log_Code):
+		if (dblTop[-1] <= 0)
+		{
+			return error(tr("invalid argument"));
+		}
+		dblTop[-1] = log(dblTop[-1]);
+		NEXT;
+
+	//--------------------
+	//  STRING FUNCTIONS
+	//--------------------
+
+	HANDLER(Asc_Code):
+		if ((--strTop)->isEmpty())
+		{
+			return error(tr("invalid argument"));
+		}
+		*intTop++ = strTop->at(0).unicode();
+		NEXT;
+	HANDLER(Asc2_Code):
+		--strTop;
+		if (intTop[-1] < 1 || intTop[-1] > strTop->length())
+		{
+			return error(tr("invalid argument"));
+		}
+		intTop[-1] = strTop->at(intTop[-1] - 1).unicode();
+		NEXT;
+	HANDLER(Chr_Code):
+		if (intTop[-1] < 0 || intTop[-1] > 0xFFFF)
+		{
+			return error(tr("invalid argument"));
+		}
+		*strTop++ = QString(QChar(*--intTop));
+		NEXT;
+	HANDLER(Instr2_Code):
+		--strTop;
+		*intTop++ = strTop[-1].indexOf(*strTop) + 1;
+		--strTop;
+		NEXT;
+	HANDLER(Instr3_Code):
+		--strTop;
+		if (intTop[-1] < 1)
+		{
+			return error(tr("invalid argument"));
+		}
+		intTop[-1] = strTop[-1].indexOf(*strTop, intTop[-1] - 1) + 1;
+		--strTop;
+		NEXT;
+	HANDLER(Left_Code):
+		if (*--intTop < 0)
+		{
+			return error(tr("invalid argument"));
+		}
+		strTop[-1] = strTop[-1].left(*intTop);
+		NEXT;
+	HANDLER(Len_Code):
+		*intTop++ = (--strTop)->length();
+		NEXT;
+	HANDLER(Mid2_Code):
+		if (*--intTop < 1)
+		{
+			return error(tr("invalid argument"));
+		}
+		strTop[-1] = strTop[-1].mid(*intTop - 1);
+		NEXT;
+	HANDLER(Mid3_Code):
+		intTop -= 2;
+		if (intTop[0] < 1 || intTop[1] < 0)
+		{
+			return error(tr("invalid argument"));
+		}
+		strTop[-1] = strTop[-1].mid(intTop[0] - 1, intTop[1]);
+		NEXT;
+	HANDLER(Repeat_Code):
+		if (*--intTop < 0)
+		{
+			return error(tr("invalid argument"));
+		}
+		strTop[-1] = strTop[-1].repeated(*intTop);
+		NEXT;
+	HANDLER(Right_Code):
+		if (*--intTop < 0)
+		{
+			return error(tr("invalid argument"));
+		}
+		strTop[-1] = strTop[-1].right(*intTop);
+		NEXT;
+	HANDLER(Space_Code):
+		if (*--intTop < 0)
+		{
+			return error(tr("invalid argument"));
+		}
+		*strTop++ = QString(*intTop, ' ');
+		NEXT;
+	HANDLER(Str_Code):
+		// (same as printed without the trailing space)
+		*strTop = printNumberText(*--dblTop);
+		(strTop++)->chop(1);
+		NEXT;
+	HANDLER(StrInt_Code):
+		*strTop = printNumberText(*--intTop);
+		(strTop++)->chop(1);
+		NEXT;
+	HANDLER(Val_Code):
+	{
+		bool ok;
+		double value = (--strTop)->trimmed().toDouble(&ok);
+		*dblTop++ = ok ? value : 0;
+		NEXT;
+	}
+
+	//-----------------
+	//  ASSIGNMENTS
+	//-----------------
+
+	HANDLER(Assign_Code):
+		*(double *)*--refTop = *--dblTop;
+		NEXT;
+	HANDLER(AssignInt_Code):
+		*(int *)*--refTop = *--intTop;
+		NEXT;
+	HANDLER(AssignStr_Code):
+		*(QString *)*--refTop = *--strTop;
+		NEXT;
+	HANDLER(AssignKeepStr_Code):
+		*(QString *)*--refTop = strTop[-1];
+		NEXT;
+
+	// (the list assignments assign to all references of the statement)
+	HANDLER(AssignList_Code):
+		--dblTop;
+		while (refTop > refBase)
+		{
+			*(double *)*--refTop = *dblTop;
+		}
+		NEXT;
+	HANDLER(AssignListInt_Code):
+		--intTop;
+		while (refTop > refBase)
+		{
+			*(int *)*--refTop = *intTop;
+		}
+		NEXT;
+	HANDLER(AssignListStr_Code):
+		--strTop;
+		while (refTop > refBase)
+		{
+			*(QString *)*--refTop = *strTop;
+		}
+		NEXT;
+
+	// (the sub-string assignments pop the arguments of the sub-string after
+	// the value, the keep forms leave the value for the next assignment)
+	HANDLER(AssignLeft_Code):
+	HANDLER(AssignKeepLeft_Code):
+		if (!assignSubStr((QString *)*--refTop, 0, *--intTop, strTop[-1]))
+		{
+			return false;
+		}
+		if (word->instructionCode() == AssignLeft_Code)
+		{
+			--strTop;
+		}
+		NEXT;
+	HANDLER(AssignMid2_Code):
+	HANDLER(AssignKeepMid2_Code):
+	{
+		QString *string = (QString *)*--refTop;
+		if (!assignSubStr(string, *--intTop - 1, string->length(),
+			strTop[-1]))
+		{
+			return false;
+		}
+		if (word->instructionCode() == AssignMid2_Code)
+		{
+			--strTop;
+		}
+		NEXT;
+	}
+	HANDLER(AssignMid3_Code):
+	HANDLER(AssignKeepMid3_Code):
+		intTop -= 2;
+		if (!assignSubStr((QString *)*--refTop, intTop[0] - 1, intTop[1],
+			strTop[-1]))
+		{
+			return false;
+		}
+		if (word->instructionCode() == AssignMid3_Code)
+		{
+			--strTop;
+		}
+		NEXT;
+	HANDLER(AssignRight_Code):
+	HANDLER(AssignKeepRight_Code):
+	{
+		QString *string = (QString *)*--refTop;
+		int count = qMin(*--intTop, string->length());
+		if (!assignSubStr(string, string->length() - count, count,
+			strTop[-1]))
+		{
+			return false;
+		}
+		if (word->instructionCode() == AssignRight_Code)
+		{
+			--strTop;
+		}
+		NEXT;
+	}
+
+	//-----------
+	//  PRINT
+	//-----------
+
+	HANDLER(PrintDbl_Code):
+		print(printNumberText(*--dblTop));
+		NEXT;
+	HANDLER(PrintInt_Code):
+		print(printNumberText(*--intTop));
+		NEXT;
+	HANDLER(PrintStr_Code):
+		print(*--strTop);
+		NEXT;
+	HANDLER(PrintConst_Code):
+		print(m_program.printConstDictionary().value(word->operand()));
+		NEXT;
+	HANDLER(Tab_Code):
+		// (move to the column of the argument, on the next line if the
+		// column has already been passed)
+		if (*--intTop < 1)
+		{
+			return error(tr("invalid argument"));
+		}
+		if (m_column >= *intTop)
+		{
+			printNewLine();
+		}
+		print(QString(*intTop - 1 - m_column, ' '));
+		NEXT;
+	HANDLER(Spc_Code):
+		if (*--intTop > 0)
+		{
+			print(QString(*intTop, ' '));
+		}
+		NEXT;
+	HANDLER(Comma_Code):
+		// (move to the beginning of the next print zone)
+		print(QString(PrintZoneWidth - m_column % PrintZoneWidth, ' '));
+		NEXT;
+	HANDLER(SemiColon_Code):
+		NEXT;  // end of print statement (stay on line)
+	HANDLER(Print_Code):
+		printNewLine();
+		NEXT;
+
+	//-----------
+	//  INPUT
+	//-----------
+
+	// (the parse codes push the data type of each input variable in the
+	// reverse order of the variables, so they are popped in the order of
+	// the variables)
+	HANDLER(InputParse_Code):
+		*typeTop++ = Double_DataType;
+		NEXT;
+	HANDLER(InputParseInt_Code):
+		*typeTop++ = Integer_DataType;
+		NEXT;
+	HANDLER(InputParseStr_Code):
+		*typeTop++ = String_DataType;
+		NEXT;
+
+	HANDLER(InputBegin_Code):
+	HANDLER(InputBeginStr_Code):
+	{
+		// (the prompt is in its own block so that it is destroyed before
+		// the next instruction is dispatched, a computed goto out of the
+		// block of a variable does not destroy it)
+		{
+			QString prompt;
+			if (word->instructionCode() == InputBegin_Code)
+			{
+				prompt = "? ";
+			}
+			else  // InputBeginStr_Code
+			{
+				prompt = *--strTop;
+				if (word->instructionHasSubCode(Option_SubCode))
+				{
+					prompt.append("? ");  // (question mark option)
+				}
+			}
+			if (!input(prompt, typeBase, typeTop))
+			{
+				return false;
+			}
+		}
+		typeTop = typeBase;
+		inputDbl = m_inputDbl.constData();
+		inputInt = m_inputInt.constData();
+		inputStr = m_inputStr.constData();
+		NEXT;
+	}
+
+	HANDLER(InputAssign_Code):
+		*(double *)*--refTop = *inputDbl++;
+		NEXT;
+	HANDLER(InputAssignInt_Code):
+		*(int *)*--refTop = *inputInt++;
+		NEXT;
+	HANDLER(InputAssignStr_Code):
+		*(QString *)*--refTop = *inputStr++;
+		NEXT;
+
+	HANDLER(Input_Code):
+	HANDLER(InputPrompt_Code):
+		NEXT;  // end of input statement
+}
+
+
+//=====================
+//  SUPPORT FUNCTIONS
+//=====================
+
+// function to replace a sub-string of a string variable
+bool Runner::assignSubStr(QString *string, int start, int count,
+	const QString &value)
+{
+	if (start < 0 || count < 0)
+	{
+		return error(tr("invalid argument"));
+	}
+	start = qMin(start, string->length());
+	string->replace(start, qMin(count, string->length() - start), value);
+	return true;
+}
+
+
+// function to return a random number from 0 to less than 1 (xorshift)
+double Runner::random(void)
+{
+	m_seed ^= m_seed << 13;
+	m_seed ^= m_seed >> 17;
+	m_seed ^= m_seed << 5;
+	return (m_seed >> 8) / 16777216.0;
+}
+
+
+//======================
+//  OUTPUT AND INPUT
+//======================
+
+// function to output a string (keeping track of the output column)
+void Runner::print(const QString &string)
+{
+	*m_output << string;
+	m_column += string.length();
+}
+
+
+// function to end the output line
+void Runner::printNewLine(void)
+{
+	*m_output << '\n';
+	m_column = 0;
+}
+
+
+// function to input the values of an input statement
+//
+//   - the data types of the values are in the reverse order of the values
+//   - the prompt is output and a line is read until a valid line is
+//     entered, a run error occurs if there are no more input lines
+
+bool Runner::input(const QString &prompt, const DataType *typeBegin,
+	const DataType *typeEnd)
+{
+	for (;;)
+	{
+		print(prompt);
+		m_output->flush();
+		QString line = m_input->readLine();
+		if (line.isNull())
+		{
+			return error(tr("end of input"));
+		}
+		m_column = 0;  // (line ended when entered)
+		if (parseInput(line, typeBegin, typeEnd))
+		{
+			return true;
+		}
+		print(tr("?Redo from start"));
+		printNewLine();
+	}
+}
+
+
+// function to parse the values of an input line
+//
+//   - values are separated by commas, spaces around values are ignored
+//   - a string value can be in quotes (so that it can contain commas)
+//   - integer values are rounded (same as assigning a double value)
+//   - returns false if a value is not valid or there are too few or too
+//     many values
+
+bool Runner::parseInput(const QString &line, const DataType *typeBegin,
+	const DataType *typeEnd)
+{
+	m_inputDbl.clear();
+	m_inputInt.clear();
+	m_inputStr.clear();
+
+	int pos = 0;
+	for (const DataType *type = typeEnd; type-- != typeBegin;)
+	{
+		while (pos < line.length() && line.at(pos) == ' ')
+		{
+			pos++;
+		}
+		QString value;
+		if (*type == String_DataType && pos < line.length()
+			&& line.at(pos) == '"')
+		{
+			int end = line.indexOf('"', pos + 1);
+			if (end == -1)
+			{
+				return false;  // no closing quote
+			}
+			value = line.mid(pos + 1, end - pos - 1);
+			for (pos = end + 1; pos < line.length() && line.at(pos) == ' ';)
+			{
+				pos++;
+			}
+			if (pos < line.length() && line.at(pos) != ',')
+			{
+				return false;  // more characters after closing quote
+			}
+		}
+		else
+		{
+			int end = line.indexOf(',', pos);
+			if (end == -1)
+			{
+				end = line.length();
+			}
+			value = line.mid(pos, end - pos).trimmed();
+			pos = end;
+		}
+
+		if (type != typeBegin)  // more values?
+		{
+			if (pos >= line.length())
+			{
+				return false;  // not enough values
+			}
+			pos++;  // skip comma
+		}
+		else if (pos < line.length())
+		{
+			return false;  // too many values
+		}
+
+		bool ok;
+		double number;
+		int numberInt;
+		switch (*type)
+		{
+		case Double_DataType:
+			number = value.toDouble(&ok);
+			if (!ok)
+			{
+				return false;
+			}
+			m_inputDbl.append(number);
+			break;
+		case Integer_DataType:
+			number = value.toDouble(&ok);
+			if (!ok || !roundInt(number, numberInt))
+			{
+				return false;
+			}
+			m_inputInt.append(numberInt);
+			break;
+		default:  // String_DataType
+			m_inputStr.append(value);
+			break;
+		}
+	}
+	return true;
+}
+
+
+// end: runner.cpp
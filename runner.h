@@ -0,0 +1,153 @@
+// vim:ts=4:sw=4:
+//
+//	Interactive BASIC Compiler Project
+//	File: runner.h - runner class header file
+//	Copyright (C) 2013  Thunder422
+//
+//	This program is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	This program is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU General Public License for more details.
+//
+//	For a copy of the GNU General Public License,
+//	see <http://www.gnu.org/licenses/>.
+//
+//
+//	Change History:
+//
+//	2013-11-02	initial version
+
+#ifndef RUNNER_H
+#define RUNNER_H
+
+#include <math.h>
+
+#include <QCoreApplication>
+#include <QString>
+#include <QVector>
+
+#include "ibcp.h"
+#include "programmodel.h"
+
+class QTextStream;
+class Table;
+
+
+// class for running the program code of a program snapshot
+//
+//   - the program code of a line is in reverse polish notation, so each
+//     instruction is run by a handler that pops its operands from the stack
+//     of their data type and pushes its result, references are pushed on
+//     their own stack
+//   - each code has a handler, the handlers are dispatched through a table
+//     of handler addresses (threaded dispatch) when supported by the
+//     compiler, otherwise by a switch statement, both are generated from
+//     the list of codes in autohandlers.h (created by enums.awk), so a code
+//     without a handler is a compiler error
+//   - the program is checked before it is run (no lines with errors and only
+//     valid codes), and the stacks are allocated for the largest line
+//     (each instruction pushes at most one item), so the handlers do not
+//     need to check the codes or the stacks
+
+class Runner
+{
+	Q_DECLARE_TR_FUNCTIONS(Runner)
+
+public:
+	explicit Runner(const ProgramSnapshot &program);
+	virtual ~Runner(void) {}
+
+	bool run(QTextStream &output, QTextStream &input);
+	QString errorMessage(void) const
+	{
+		return m_errorMessage;
+	}
+
+protected:
+	enum {
+		PrintZoneWidth = 14				// width of print zones (commas)
+	};
+
+	// functions that are replaced to run other code (see RegisterRunner)
+	virtual bool check(void);
+	virtual bool runLine(int lineIndex);
+
+	void allocate(int maxSize);
+	bool error(const QString &message);
+	bool assignSubStr(QString *string, int start, int count,
+		const QString &value);
+
+	// output and input functions
+	void print(const QString &string);
+	void printNewLine(void);
+	bool input(const QString &prompt, const DataType *typeBegin,
+		const DataType *typeEnd);
+
+	double random(void);
+
+	Table &m_table;						// reference to the table instance
+	ProgramSnapshot m_program;			// program being run
+	int m_lineIndex;					// index of line being run
+
+	// number constant values of the program
+	const int *m_constIndex;			// value indexes of constants
+	const double *m_constValue;			// double values of constants
+	const qint32 *m_constValueInt;		// integer values of constants
+
+	// values of the variables of the program
+	QVector<double> m_varDbl;
+	QVector<int> m_varInt;
+	QVector<QString> m_varStr;
+
+	// stacks of the items of a line
+	QVector<double> m_dblStack;
+	QVector<int> m_intStack;
+	QVector<QString> m_strStack;
+	QVector<void *> m_refStack;			// variable references
+	QVector<DataType> m_typeStack;		// data types of input values
+
+	// values of an input statement (in the order of the variables)
+	QVector<double> m_inputDbl;
+	QVector<int> m_inputInt;
+	QVector<QString> m_inputStr;
+
+	int m_column;						// column of output line
+
+private:
+	bool runCode(const ProgramWord *word, const ProgramWord *end);
+	bool parseInput(const QString &line, const DataType *typeBegin,
+		const DataType *typeEnd);
+
+	QString m_errorMessage;				// message of run error
+	QTextStream *m_output;				// output stream of program
+	QTextStream *m_input;				// input stream of program
+	quint32 m_seed;						// random number generator state
+};
+
+
+// function to check if a value is within the range of an integer
+inline bool fitsInt(double value)
+{
+	return value > -2147483649.0 && value < 2147483648.0;
+}
+
+
+// function to round a value to an integer (returns false on overflow)
+inline bool roundInt(double value, int &result)
+{
+	value = floor(value + 0.5);
+	if (!fitsInt(value))
+	{
+		return false;
+	}
+	result = (int)value;
+	return true;
+}
+
+
+#endif  // RUNNER_H
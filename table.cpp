@@ -26,14 +26,10 @@
 #include <QString>
 
 #include "table.h"
+#include "recreator.h"
 #include "basic/basic.h"
 
 
-const int MaxOperands = 3;
-	// this value contains the maximum number of operands
-	// (arguments) for any operator or internal function (there are currently
-	// no internal function with more than 3 arguments)
-
 const int MaxAssocCodes = 3;
 	// this value contains the maximum number of associated codes,
 	// codes in additional to the main code for different possible data types
@@ -94,28 +90,20 @@ static Code cvtCodeHaveNeed[sizeof_DataType][sizeof_DataType] = {
 
 
 // expression information for operators and internal functions
+//
+//   - initialized as constant data (no constructor) so that the table
+//     requires no initialization at startup
+//   - members after the expected data type may be omitted (zero)
+
 struct ExprInfo
 {
 	Code m_unaryCode;				// operator unary code (Null_Code if none)
 	short m_operandCount;			// number of operands (operators/functions)
+	const DataType *m_operandDataType;	// data type of each operand
+	DataType m_expectedDataType;	// expected data type of next operand
 	short m_associatedCodeCount;	// number of associated codes
 	short m_secondAssociatedIndex;	// index of second operand associated codes
-	DataType *m_operandDataType;	// data type of each operand
-	Code *m_associatedCode;			// associated codes
-	DataType m_expectedDataType;	// expected data type of next operand
-
-	ExprInfo(Code unaryCode = Null_Code, short operandCount = 0,
-		DataType *operandDataType = NULL, short associatedCodeCount = 0,
-		short secondAssociatedIndex = 0, Code *associatedCode = NULL,
-		DataType expectedDataType = None_DataType) :
-		m_unaryCode(unaryCode), m_operandCount(operandCount),
-		m_operandDataType(operandDataType),
-		m_associatedCodeCount(associatedCodeCount),
-		m_secondAssociatedIndex(secondAssociatedIndex),
-		m_associatedCode(associatedCode),
-		m_expectedDataType(expectedDataType)
-	{
-	}
+	const Code *m_associatedCode;	// associated codes
 };
 
 
@@ -123,25 +111,25 @@ struct TableEntry
 {
 	TokenType type;					// type of token for entry
 	Multiple multiple;				// multiple word command/character operator
-	const QString name;				// name for table entry
-	const QString name2;			// name of second word of command
-	const QString option;			// name of option sub-code
+	const char *name;				// name for table entry
+	const char *name2;				// name of second word of command
+	const char *option;				// name of option sub-code
 	int flags;						// flags for entry
 	int precedence;					// precedence of code
 	DataType dataType;				// next expression data type for command
-	ExprInfo *exprInfo;				// expression info pointer (NULL for none)
+	const ExprInfo *exprInfo;		// expression info pointer (NULL for none)
 	TranslateFunction translate;	// pointer to translate function
 	EncodeFunction encode;			// pointer to encode function
 	OperandTextFunction operandText;// pointer to operand text function
 	RemoveFunction remove;			// pointer to remove function
+	RecreateFunction recreate;		// pointer to recreate function
 };
 
 
-Table *Table::s_instance;			// pointer to single table instance
-QStringList Table::s_errorList;		// list of errors found during initialize
+Table Table::s_instance;			// single table instance
 
 
-// this macro produces two entries for the ExprInfo constructor,
+// this macro produces two entries for the ExprInfo initializer,
 // one for the number of operands, one for the pointer to the
 // operand data type array
 #define Operands(type)  (sizeof(type ## _OperandArray) \
@@ -157,134 +145,313 @@ QStringList Table::s_errorList;		// list of errors found during initialize
 
 
 // operand data type arrays
-static DataType Dbl_OperandArray[] = {
+static const DataType Dbl_OperandArray[] = {
 	Double_DataType
 };
-static DataType DblDbl_OperandArray[] = {
+static const DataType DblDbl_OperandArray[] = {
 	Double_DataType, Double_DataType
 };
-static DataType DblInt_OperandArray[] = {
+static const DataType DblInt_OperandArray[] = {
 	Double_DataType, Integer_DataType
 };
 
-static DataType Int_OperandArray[] = {
+static const DataType Int_OperandArray[] = {
 	Integer_DataType
 };
-static DataType IntDbl_OperandArray[] = {
+static const DataType IntDbl_OperandArray[] = {
 	Integer_DataType, Double_DataType
 };
-static DataType IntInt_OperandArray[] = {
+static const DataType IntInt_OperandArray[] = {
 	Integer_DataType, Integer_DataType
 };
 
-static DataType Str_OperandArray[] = {
+static const DataType Str_OperandArray[] = {
 	String_DataType
 };
-static DataType StrInt_OperandArray[] = {
+static const DataType StrInt_OperandArray[] = {
 	String_DataType, Integer_DataType
 };
-static DataType StrIntInt_OperandArray[] = {
+static const DataType StrIntInt_OperandArray[] = {
 	String_DataType, Integer_DataType, Integer_DataType
 };
-static DataType StrStr_OperandArray[] = {
+static const DataType StrStr_OperandArray[] = {
 	String_DataType, String_DataType
 };
-static DataType StrStrInt_OperandArray[] = {
+static const DataType StrStrInt_OperandArray[] = {
 	String_DataType, String_DataType, Integer_DataType
 };
 
 
 // associated code data type arrays
-static Code Abs_AssocCode[]				= {AbsInt_Code};
-static Code Add_AssocCode[]				= {
+static const Code Abs_AssocCode[]			= {AbsInt_Code};
+static const Code Add_AssocCode[]			= {
 	AddInt_Code, CatStr_Code, AddI2_Code
 };
-static Code AddInt_AssocCode[]			= {AddI1_Code};
-static Code Assign_AssocCode[]			= {
+static const Code AddInt_AssocCode[]		= {AddI1_Code};
+static const Code Assign_AssocCode[]		= {
 	AssignInt_Code, AssignStr_Code, AssignList_Code
 };
-static Code AssignLeft_AssocCode[]		= {AssignKeepLeft_Code};
-static Code AssignInt_AssocCode[]		= {AssignListInt_Code};
-static Code AssignMid2_AssocCode[]		= {AssignKeepMid2_Code};
-static Code AssignMid3_AssocCode[]		= {AssignKeepMid3_Code};
-static Code AssignRight_AssocCode[]		= {AssignKeepRight_Code};
-static Code AssignStr_AssocCode[]		= {
+static const Code AssignLeft_AssocCode[]	= {AssignKeepLeft_Code};
+static const Code AssignInt_AssocCode[]		= {AssignListInt_Code};
+static const Code AssignMid2_AssocCode[]	= {AssignKeepMid2_Code};
+static const Code AssignMid3_AssocCode[]	= {AssignKeepMid3_Code};
+static const Code AssignRight_AssocCode[]	= {AssignKeepRight_Code};
+static const Code AssignStr_AssocCode[]		= {
 	AssignKeepStr_Code, AssignListStr_Code
 };
-static Code Const_AssocCode[]			= {ConstInt_Code, ConstStr_Code};
-static Code Div_AssocCode[]				= {DivInt_Code, DivI2_Code};
-static Code DivInt_AssocCode[]			= {DivI1_Code};
-static Code Eq_AssocCode[]				= {
+static const Code Const_AssocCode[]			= {ConstInt_Code, ConstStr_Code};
+static const Code Div_AssocCode[]			= {DivInt_Code, DivI2_Code};
+static const Code DivInt_AssocCode[]		= {DivI1_Code};
+static const Code Eq_AssocCode[]			= {
 	EqInt_Code, EqStr_Code, EqI2_Code
 };
-static Code EqInt_AssocCode[]			= {EqI1_Code};
-static Code Gt_AssocCode[]				= {
+static const Code EqInt_AssocCode[]			= {EqI1_Code};
+static const Code Gt_AssocCode[]			= {
 	GtInt_Code, GtStr_Code, GtI2_Code
 };
-static Code GtInt_AssocCode[]			= {GtI1_Code};
-static Code GtEq_AssocCode[]			= {
+static const Code GtInt_AssocCode[]			= {GtI1_Code};
+static const Code GtEq_AssocCode[]			= {
 	GtEqInt_Code, GtEqStr_Code, GtEqI2_Code
 };
-static Code GtEqInt_AssocCode[]			= {GtEqI1_Code};
-static Code InputAssign_AssocCode[]		= {
+static const Code GtEqInt_AssocCode[]		= {GtEqI1_Code};
+static const Code InputAssign_AssocCode[]	= {
 	InputAssignInt_Code, InputAssignStr_Code, InputParse_Code
 };
-static Code InputAssignInt_AssocCode[]	= {InputParseInt_Code};
-static Code InputAssignStr_AssocCode[]	= {InputParseStr_Code};
-static Code Left_AssocCode[]			= {AssignLeft_Code};
-static Code Lt_AssocCode[]				= {
+static const Code InputAssignInt_AssocCode[]	= {InputParseInt_Code};
+static const Code InputAssignStr_AssocCode[]	= {InputParseStr_Code};
+static const Code Left_AssocCode[]			= {AssignLeft_Code};
+static const Code Lt_AssocCode[]			= {
 	LtInt_Code, LtStr_Code, LtI2_Code
 };
-static Code LtInt_AssocCode[]			= {LtI1_Code};
-static Code LtEq_AssocCode[]			= {
+static const Code LtInt_AssocCode[]			= {LtI1_Code};
+static const Code LtEq_AssocCode[]			= {
 	LtEqInt_Code, LtEqStr_Code, LtEqI2_Code
 };
-static Code LtEqInt_AssocCode[]			= {LtEqI1_Code};
-static Code Mid2_AssocCode[]			= {AssignMid2_Code};
-static Code Mid3_AssocCode[]			= {AssignMid3_Code};
-static Code Mod_AssocCode[]				= {ModInt_Code, ModI2_Code};
-static Code ModInt_AssocCode[]			= {ModI1_Code};
-static Code Mul_AssocCode[]				= {MulInt_Code, MulI2_Code};
-static Code MulInt_AssocCode[]			= {MulI1_Code};
-static Code Neg_AssocCode[]				= {NegInt_Code};
-static Code NotEq_AssocCode[]			= {
+static const Code LtEqInt_AssocCode[]		= {LtEqI1_Code};
+static const Code Mid2_AssocCode[]			= {AssignMid2_Code};
+static const Code Mid3_AssocCode[]			= {AssignMid3_Code};
+static const Code Mod_AssocCode[]			= {ModInt_Code, ModI2_Code};
+static const Code ModInt_AssocCode[]		= {ModI1_Code};
+static const Code Mul_AssocCode[]			= {MulInt_Code, MulI2_Code};
+static const Code MulInt_AssocCode[]		= {MulI1_Code};
+static const Code Neg_AssocCode[]			= {NegInt_Code};
+static const Code NotEq_AssocCode[]			= {
 	NotEqInt_Code, NotEqStr_Code, NotEqI2_Code
 };
-static Code NotEqInt_AssocCode[] 		= {NotEqI1_Code};
-static Code Power_AssocCode[]			= {PowerInt_Code, PowerMul_Code};
-static Code PowerInt_AssocCode[]		= {PowerI1_Code};
-static Code Print_AssocCode[]			= {
+static const Code NotEqInt_AssocCode[]		= {NotEqI1_Code};
+static const Code Power_AssocCode[]			= {PowerInt_Code, PowerMul_Code};
+static const Code PowerInt_AssocCode[]		= {PowerI1_Code};
+static const Code Print_AssocCode[]			= {
 	PrintInt_Code, PrintStr_Code
 };
-static Code Right_AssocCode[]			= {AssignRight_Code};
-static Code RndArgs_AssocCode[]			= {RndArgInt_Code};
-static Code Sgn_AssocCode[]				= {SgnInt_Code};
-static Code Str_AssocCode[]				= {StrInt_Code};
-static Code Sub_AssocCode[]				= {SubInt_Code, SubI2_Code};
-static Code SubInt_AssocCode[]			= {SubI1_Code};
-static Code Var_AssocCode[]				= {VarInt_Code, VarStr_Code};
-static Code VarRef_AssocCode[]			= {VarRefInt_Code, VarRefStr_Code};
+static const Code Right_AssocCode[]			= {AssignRight_Code};
+static const Code RndArgs_AssocCode[]		= {RndArgInt_Code};
+static const Code Sgn_AssocCode[]			= {SgnInt_Code};
+static const Code Str_AssocCode[]			= {StrInt_Code};
+static const Code Sub_AssocCode[]			= {SubInt_Code, SubI2_Code};
+static const Code SubInt_AssocCode[]		= {SubI1_Code};
+static const Code Var_AssocCode[]			= {VarInt_Code, VarStr_Code};
+static const Code VarRef_AssocCode[]		= {VarRefInt_Code, VarRefStr_Code};
 
 
 // standard expression information structures
-static ExprInfo Dbl_ExprInfo(Null_Code, Operands(Dbl));
-static ExprInfo DblDbl_ExprInfo(Null_Code, Operands(DblDbl));
-static ExprInfo DblInt_ExprInfo(Null_Code, Operands(DblInt));
-
-static ExprInfo Int_ExprInfo(Null_Code, Operands(Int));
-static ExprInfo IntInt_ExprInfo(Null_Code, Operands(IntInt));
-static ExprInfo IntDbl_ExprInfo(Null_Code, Operands(IntDbl));
-
-static ExprInfo Str_ExprInfo(Null_Code, Operands(Str));
-static ExprInfo StrInt_ExprInfo(Null_Code, Operands(StrInt));
-static ExprInfo StrStr_ExprInfo(Null_Code, Operands(StrStr));
-static ExprInfo StrStrInt_ExprInfo(Null_Code, Operands(StrStrInt));
-
-static ExprInfo StrIntInt_ExprInfo(Null_Code, Operands(StrIntInt));
+static const ExprInfo Dbl_ExprInfo = {Null_Code, Operands(Dbl),
+	Double_DataType};
+static const ExprInfo DblDbl_ExprInfo = {Null_Code, Operands(DblDbl),
+	Double_DataType};
+static const ExprInfo DblInt_ExprInfo = {Null_Code, Operands(DblInt),
+	Integer_DataType};
+
+static const ExprInfo Int_ExprInfo = {Null_Code, Operands(Int),
+	Integer_DataType};
+static const ExprInfo IntInt_ExprInfo = {Null_Code, Operands(IntInt),
+	Integer_DataType};
+static const ExprInfo IntDbl_ExprInfo = {Null_Code, Operands(IntDbl),
+	Double_DataType};
+
+static const ExprInfo Str_ExprInfo = {Null_Code, Operands(Str),
+	String_DataType};
+static const ExprInfo StrInt_ExprInfo = {Null_Code, Operands(StrInt),
+	String_DataType};
+static const ExprInfo StrStr_ExprInfo = {Null_Code, Operands(StrStr),
+	String_DataType};
+static const ExprInfo StrStrInt_ExprInfo = {Null_Code, Operands(StrStrInt),
+	String_DataType};
+
+static const ExprInfo StrIntInt_ExprInfo = {Null_Code, Operands(StrIntInt),
+	String_DataType};
+
+// expression information structures for specific codes
+static const ExprInfo Rnd_ExprInfo = {Null_Code, 0, NULL, None_DataType};
+static const ExprInfo Mod_ExprInfo = {
+	Null_Code, Operands(DblDbl), Number_DataType, AssocCode2(Mod, 1)
+};
+static const ExprInfo Not_ExprInfo = {
+	Not_Code, Operands(Int), Integer_DataType
+};
+static const ExprInfo Abs_ExprInfo = {
+	Null_Code, Operands(Dbl), Number_DataType, AssocCode(Abs)
+};
+static const ExprInfo RndArg_ExprInfo = {
+	Null_Code, Operands(Dbl), Number_DataType, AssocCode(RndArgs)
+};
+static const ExprInfo Sgn_ExprInfo = {
+	Null_Code, Operands(Dbl), Number_DataType, AssocCode(Sgn)
+};
+static const ExprInfo Asc_ExprInfo = {
+	Null_Code, Operands(Str), String_DataType
+};
+static const ExprInfo Asc2_ExprInfo = {
+	Null_Code, Operands(StrInt), String_DataType
+};
+static const ExprInfo Instr3_ExprInfo = {
+	Null_Code, Operands(StrStrInt), String_DataType
+};
+static const ExprInfo Left_ExprInfo = {
+	Null_Code, Operands(StrInt), String_DataType, AssocCode2(Left, -1)
+};
+static const ExprInfo Len_ExprInfo = {
+	Null_Code, Operands(Str), String_DataType
+};
+static const ExprInfo Mid2_ExprInfo = {
+	Null_Code, Operands(StrInt), String_DataType, AssocCode2(Mid2, -1)
+};
+static const ExprInfo Mid3_ExprInfo = {
+	Null_Code, Operands(StrIntInt), String_DataType, AssocCode2(Mid3, -1)
+};
+static const ExprInfo Repeat_ExprInfo = {
+	Null_Code, Operands(StrInt), String_DataType
+};
+static const ExprInfo Right_ExprInfo = {
+	Null_Code, Operands(StrInt), String_DataType, AssocCode2(Right, -1)
+};
+static const ExprInfo StrFunc_ExprInfo = {
+	Null_Code, Operands(Dbl), Number_DataType, AssocCode(Str)
+};
+static const ExprInfo Add_ExprInfo = {
+	Null_Code, Operands(DblDbl), Number_DataType, AssocCode2(Add, 2)
+};
+static const ExprInfo Sub_ExprInfo = {
+	Neg_Code, Operands(DblDbl), Number_DataType, AssocCode2(Sub, 1)
+};
+static const ExprInfo Mul_ExprInfo = {
+	Null_Code, Operands(DblDbl), Number_DataType, AssocCode2(Mul, 1)
+};
+static const ExprInfo Div_ExprInfo = {
+	Null_Code, Operands(DblDbl), Number_DataType, AssocCode2(Div, 1)
+};
+static const ExprInfo Power_ExprInfo = {
+	Null_Code, Operands(DblDbl), Number_DataType, AssocCode2(Power, 1)
+};
+static const ExprInfo Eq_ExprInfo = {
+	Null_Code, Operands(DblDbl), Number_DataType, AssocCode2(Eq, 2)
+};
+static const ExprInfo Gt_ExprInfo = {
+	Null_Code, Operands(DblDbl), Number_DataType, AssocCode2(Gt, 2)
+};
+static const ExprInfo GtEq_ExprInfo = {
+	Null_Code, Operands(DblDbl), Number_DataType, AssocCode2(GtEq, 2)
+};
+static const ExprInfo Lt_ExprInfo = {
+	Null_Code, Operands(DblDbl), Number_DataType, AssocCode2(Lt, 2)
+};
+static const ExprInfo LtEq_ExprInfo = {
+	Null_Code, Operands(DblDbl), Number_DataType, AssocCode2(LtEq, 2)
+};
+static const ExprInfo NotEq_ExprInfo = {
+	Null_Code, Operands(DblDbl), Number_DataType, AssocCode2(NotEq, 2)
+};
+static const ExprInfo Neg_ExprInfo = {
+	Neg_Code, Operands(Dbl), Number_DataType, AssocCode(Neg)
+};
+static const ExprInfo Assign_ExprInfo = {
+	Null_Code, Operands(DblDbl), Double_DataType, AssocCode2(Assign, 2)
+};
+static const ExprInfo AssignInt_ExprInfo = {
+	Null_Code, Operands(IntInt), Integer_DataType, AssocCode(AssignInt)
+};
+static const ExprInfo AssignStr_ExprInfo = {
+	Null_Code, Operands(StrStr), String_DataType, AssocCode2(AssignStr, 1)
+};
+static const ExprInfo AssignLeft_ExprInfo = {
+	Null_Code, Operands(StrStr), String_DataType, AssocCode(AssignLeft)
+};
+static const ExprInfo AssignMid2_ExprInfo = {
+	Null_Code, Operands(StrStr), String_DataType, AssocCode(AssignMid2)
+};
+static const ExprInfo AssignMid3_ExprInfo = {
+	Null_Code, Operands(StrStr), String_DataType, AssocCode(AssignMid3)
+};
+static const ExprInfo AssignRight_ExprInfo = {
+	Null_Code, Operands(StrStr), String_DataType, AssocCode(AssignRight)
+};
+static const ExprInfo AddInt_ExprInfo = {
+	Null_Code, Operands(IntInt), Number_DataType, AssocCode(AddInt)
+};
+static const ExprInfo SubInt_ExprInfo = {
+	Null_Code, Operands(IntInt), Number_DataType, AssocCode(SubInt)
+};
+static const ExprInfo NegInt_ExprInfo = {
+	NegInt_Code, Operands(Int), Integer_DataType
+};
+static const ExprInfo MulInt_ExprInfo = {
+	Null_Code, Operands(IntInt), Number_DataType, AssocCode(MulInt)
+};
+static const ExprInfo DivInt_ExprInfo = {
+	Null_Code, Operands(IntInt), Number_DataType, AssocCode(DivInt)
+};
+static const ExprInfo ModInt_ExprInfo = {
+	Null_Code, Operands(IntInt), Number_DataType, AssocCode(ModInt)
+};
+static const ExprInfo PowerInt_ExprInfo = {
+	Null_Code, Operands(IntInt), Number_DataType, AssocCode(PowerInt)
+};
+static const ExprInfo EqInt_ExprInfo = {
+	Null_Code, Operands(IntInt), Number_DataType, AssocCode(EqInt)
+};
+static const ExprInfo GtInt_ExprInfo = {
+	Null_Code, Operands(IntInt), Number_DataType, AssocCode(GtInt)
+};
+static const ExprInfo GtEqInt_ExprInfo = {
+	Null_Code, Operands(IntInt), Number_DataType, AssocCode(GtEqInt)
+};
+static const ExprInfo LtInt_ExprInfo = {
+	Null_Code, Operands(IntInt), Number_DataType, AssocCode(LtInt)
+};
+static const ExprInfo LtEqInt_ExprInfo = {
+	Null_Code, Operands(IntInt), Number_DataType, AssocCode(LtEqInt)
+};
+static const ExprInfo NotEqInt_ExprInfo = {
+	Null_Code, Operands(IntInt), Number_DataType, AssocCode(NotEqInt)
+};
+static const ExprInfo PrintDbl_ExprInfo = {
+	Null_Code, Operands(Dbl), Any_DataType, AssocCode(Print)
+};
+static const ExprInfo InputBeginStr_ExprInfo = {
+	Null_Code, Operands(Str), String_DataType
+};
+static const ExprInfo InputAssign_ExprInfo = {
+	Null_Code, Operands(Dbl), Double_DataType, AssocCode2(InputAssign, 2)
+};
+static const ExprInfo InputAssignInt_ExprInfo = {
+	Null_Code, Operands(Int), Integer_DataType, AssocCode(InputAssignInt)
+};
+static const ExprInfo InputAssignStr_ExprInfo = {
+	Null_Code, Operands(Str), String_DataType, AssocCode(InputAssignStr)
+};
+static const ExprInfo Const_ExprInfo = {
+	Null_Code, Operands(Dbl), Any_DataType, AssocCode(Const)
+};
+static const ExprInfo Var_ExprInfo = {
+	Null_Code, Operands(Dbl), Any_DataType, AssocCode(Var)
+};
+static const ExprInfo VarRef_ExprInfo = {
+	Null_Code, Operands(Dbl), Any_DataType, AssocCode(VarRef)
+};
 
 // code enumeration names in comments after opening brace
 // (code enumeration generated from these by enums.awk)
-static TableEntry tableEntries[] =
+static const TableEntry tableEntries[] =
 {
 	// Null_Code entry at beginning so Null_Code == 0
 	{	// Null_Code
@@ -310,21 +477,19 @@ static TableEntry tableEntries[] =
 		Command_TokenType, OneWord_Multiple,
 		"PRINT", NULL, NULL,
 		Null_Flag, 4, None_DataType, NULL,
-		printTranslate
+		printTranslate, NULL, NULL, NULL, printRecreate
 	},
 	{	// Input_Code
 		Command_TokenType, TwoWord_Multiple,
 		"INPUT", NULL, "Keep",
 		Null_Flag, 4, None_DataType, NULL,
-		inputTranslate
-
+		inputTranslate, NULL, NULL, NULL, inputRecreate
 	},
 	{	// InputPrompt_Code
 		Command_TokenType, TwoWord_Multiple,
 		"INPUT", "PROMPT", "Keep",
 		Null_Flag, 4, String_DataType, NULL,
-		inputTranslate
-
+		inputTranslate, NULL, NULL, NULL, inputRecreate
 	},
 	{	// Dim_Code
 		Command_TokenType, OneWord_Multiple,
@@ -340,7 +505,7 @@ static TableEntry tableEntries[] =
 		Command_TokenType, OneWord_Multiple,
 		"REM", NULL, NULL,
 		HasOperand_Flag, 4, None_DataType, NULL,
-		NULL, remEncode, remOperandText, remRemove
+		NULL, remEncode, remOperandText, remRemove, remRecreate
 	},
 	{	// If_Code
 		Command_TokenType, OneWord_Multiple,
@@ -433,7 +598,7 @@ static TableEntry tableEntries[] =
 	{	// Rnd_Code
 		IntFuncN_TokenType, OneWord_Multiple,
 		"RND", NULL, NULL,
-		Null_Flag, 2, Double_DataType, new ExprInfo()
+		Null_Flag, 2, Double_DataType, &Rnd_ExprInfo
 
 	},
 	//--------------------
@@ -442,8 +607,7 @@ static TableEntry tableEntries[] =
 	{	// Mod_Code
 		Operator_TokenType, OneWord_Multiple,
 		"MOD", NULL, NULL,
-		Null_Flag, 42, Double_DataType,
-		new ExprInfo(Null_Code, Operands(DblDbl), AssocCode2(Mod, 1))
+		Null_Flag, 42, Double_DataType, &Mod_ExprInfo
 	},
 	{	// And_Code
 		Operator_TokenType, OneWord_Multiple,
@@ -458,8 +622,7 @@ static TableEntry tableEntries[] =
 	{	// Not_Code
 		Operator_TokenType, OneWord_Multiple,
 		"NOT", NULL, NULL,
-		Null_Flag, 20, Integer_DataType,
-		new ExprInfo(Not_Code, Operands(Int))
+		Null_Flag, 20, Integer_DataType, &Not_ExprInfo
 	},
 	{	// Eqv_Code
 		Operator_TokenType, OneWord_Multiple,
@@ -494,8 +657,7 @@ static TableEntry tableEntries[] =
 	{	// Abs_Code
 		IntFuncP_TokenType, OneWord_Multiple,
 		"ABS(", NULL, NULL,
-		Null_Flag, 2, Double_DataType,
-		new ExprInfo(Null_Code, Operands(Dbl), AssocCode(Abs))
+		Null_Flag, 2, Double_DataType, &Abs_ExprInfo
 	},
 	{	// Fix_Code
 		IntFuncP_TokenType, OneWord_Multiple,
@@ -516,14 +678,12 @@ static TableEntry tableEntries[] =
 	{	// RndArg_Code
 		IntFuncP_TokenType, OneWord_Multiple,
 		"RND(", NULL, NULL,
-		Null_Flag, 2, Double_DataType,
-		new ExprInfo(Null_Code, Operands(Dbl), AssocCode(RndArgs))
+		Null_Flag, 2, Double_DataType, &RndArg_ExprInfo
 	},
 	{	// Sgn_Code
 		IntFuncP_TokenType, OneWord_Multiple,
 		"SGN(", NULL, NULL,
-		Null_Flag, 2, Double_DataType,
-		new ExprInfo(Null_Code, Operands(Dbl), AssocCode(Sgn))
+		Null_Flag, 2, Double_DataType, &Sgn_ExprInfo
 	},
 	{	// Cint_Code
 		IntFuncP_TokenType, OneWord_Multiple,
@@ -573,24 +733,24 @@ static TableEntry tableEntries[] =
 	{	// Tab_Code
 		IntFuncP_TokenType, OneWord_Multiple,
 		"TAB(", NULL, NULL,
-		Print_Flag, 2, None_DataType, &Int_ExprInfo
+		Print_Flag, 2, None_DataType, &Int_ExprInfo,
+		NULL, NULL, NULL, NULL, printFunctionRecreate
 	},
 	{	// Spc_Code
 		IntFuncP_TokenType, OneWord_Multiple,
 		"SPC(", NULL, NULL,
-		Print_Flag, 2, None_DataType, &Int_ExprInfo
+		Print_Flag, 2, None_DataType, &Int_ExprInfo,
+		NULL, NULL, NULL, NULL, printFunctionRecreate
 	},
 	{	// Asc_Code
 		IntFuncP_TokenType, OneWord_Multiple,
 		"ASC(", NULL, NULL,
-		Multiple_Flag, 2, Integer_DataType,
-		new ExprInfo(Null_Code, Operands(Str))
+		Multiple_Flag, 2, Integer_DataType, &Asc_ExprInfo
 	},
 	{	// Asc2_Code
 		IntFuncP_TokenType, OneWord_Multiple,
 		"ASC(", "ASC2(", NULL,
-		Null_Flag, 2, Integer_DataType,
-		new ExprInfo(Null_Code, Operands(StrInt))
+		Null_Flag, 2, Integer_DataType, &Asc2_ExprInfo
 	},
 	{	// Chr_Code
 		IntFuncP_TokenType, OneWord_Multiple,
@@ -600,50 +760,42 @@ static TableEntry tableEntries[] =
 	{	// Instr2_Code
 		IntFuncP_TokenType, OneWord_Multiple,
 		"INSTR(", "INSTR2(", NULL,
-		Multiple_Flag, 2, Integer_DataType,
-		&StrStr_ExprInfo
+		Multiple_Flag, 2, Integer_DataType, &StrStr_ExprInfo
 	},
 	{	// Instr3_Code
 		IntFuncP_TokenType, OneWord_Multiple,
 		"INSTR(", "INSTR3(", NULL,
-		Null_Flag, 2, Integer_DataType,
-		new ExprInfo(Null_Code, Operands(StrStrInt))
+		Null_Flag, 2, Integer_DataType, &Instr3_ExprInfo
 	},
 	{	// Left_Code
 		IntFuncP_TokenType, OneWord_Multiple,
 		"LEFT$(", NULL, NULL,
-		SubStr_Flag, 2, String_DataType,
-		new ExprInfo(Null_Code, Operands(StrInt), AssocCode2(Left, -1))
+		SubStr_Flag, 2, String_DataType, &Left_ExprInfo
 	},
 	{	// Len_Code
 		IntFuncP_TokenType, OneWord_Multiple,
 		"LEN(", NULL, NULL,
-		Null_Flag, 2, Integer_DataType,
-		new ExprInfo(Null_Code, Operands(Str))
+		Null_Flag, 2, Integer_DataType, &Len_ExprInfo
 	},
 	{	// Mid2_Code
 		IntFuncP_TokenType, OneWord_Multiple,
 		"MID$(", "MID2$(", NULL,
-		Multiple_Flag | SubStr_Flag, 2, String_DataType,
-		new ExprInfo(Null_Code, Operands(StrInt), AssocCode2(Mid2, -1))
+		Multiple_Flag | SubStr_Flag, 2, String_DataType, &Mid2_ExprInfo
 	},
 	{	// Mid3_Code
 		IntFuncP_TokenType, OneWord_Multiple,
 		"MID$(", "MID3$(", NULL,
-		SubStr_Flag, 2, String_DataType,
-		new ExprInfo(Null_Code, Operands(StrIntInt), AssocCode2(Mid3, -1))
+		SubStr_Flag, 2, String_DataType, &Mid3_ExprInfo
 	},
 	{	// Repeat_Code
 		IntFuncP_TokenType, OneWord_Multiple,
 		"REPEAT$(", NULL, NULL,
-		Null_Flag, 2, String_DataType,
-		new ExprInfo(Null_Code, Operands(StrInt))
+		Null_Flag, 2, String_DataType, &Repeat_ExprInfo
 	},
 	{	// Right_Code
 		IntFuncP_TokenType, OneWord_Multiple,
 		"RIGHT$(", NULL, NULL,
-		SubStr_Flag, 2, String_DataType,
-		new ExprInfo(Null_Code, Operands(StrInt), AssocCode2(Right, -1))
+		SubStr_Flag, 2, String_DataType, &Right_ExprInfo
 	},
 	{	// Space_Code
 		IntFuncP_TokenType, OneWord_Multiple,
@@ -653,8 +805,7 @@ static TableEntry tableEntries[] =
 	{	// Str_Code
 		IntFuncP_TokenType, OneWord_Multiple,
 		"STR$(", NULL, NULL,
-		Null_Flag, 2, String_DataType,
-		new ExprInfo(Null_Code, Operands(Dbl), AssocCode(Str))
+		Null_Flag, 2, String_DataType, &StrFunc_ExprInfo
 	},
 	{	// Val_Code
 		IntFuncP_TokenType, OneWord_Multiple,
@@ -693,26 +844,22 @@ static TableEntry tableEntries[] =
 	{	// Add_Code
 		Operator_TokenType, OneChar_Multiple,
 		"+", NULL, NULL,
-		Null_Flag, 40, Double_DataType,
-		new ExprInfo(Null_Code, Operands(DblDbl), AssocCode2(Add, 2))
+		Null_Flag, 40, Double_DataType, &Add_ExprInfo
 	},
 	{	// Sub_Code
 		Operator_TokenType, OneChar_Multiple,
 		"-", NULL, NULL,
-		Null_Flag, 40, Double_DataType,
-		new ExprInfo(Neg_Code, Operands(DblDbl), AssocCode2(Sub, 1))
+		Null_Flag, 40, Double_DataType, &Sub_ExprInfo
 	},
 	{	// Mul_Code
 		Operator_TokenType, OneChar_Multiple,
 		"*", NULL, NULL,
-		Null_Flag, 46, Double_DataType,
-		new ExprInfo(Null_Code, Operands(DblDbl), AssocCode2(Mul, 1))
+		Null_Flag, 46, Double_DataType, &Mul_ExprInfo
 	},
 	{	// Div_Code
 		Operator_TokenType, OneChar_Multiple,
 		"/", NULL, NULL,
-		Null_Flag, 46, Double_DataType,
-		new ExprInfo(Null_Code, Operands(DblDbl), AssocCode2(Div, 1))
+		Null_Flag, 46, Double_DataType, &Div_ExprInfo
 	},
 	{	// IntDiv_Code
 		Operator_TokenType, OneChar_Multiple,
@@ -722,44 +869,37 @@ static TableEntry tableEntries[] =
 	{	// Power_Code
 		Operator_TokenType, OneChar_Multiple,
 		"^", NULL, NULL,
-		UseConstAsIs_Flag, 50, Double_DataType,
-		new ExprInfo(Null_Code, Operands(DblDbl), AssocCode2(Power, 1))
+		UseConstAsIs_Flag, 50, Double_DataType, &Power_ExprInfo
 	},
 	{	// Eq_Code
 		Operator_TokenType, OneChar_Multiple,
 		"=", NULL, NULL,
-		Null_Flag, 30, Integer_DataType,
-		new ExprInfo(Null_Code, Operands(DblDbl), AssocCode2(Eq, 2))
+		Null_Flag, 30, Integer_DataType, &Eq_ExprInfo
 	},
 	{	// Gt_Code
 		Operator_TokenType, TwoChar_Multiple,
 		">", NULL, NULL,
-		Null_Flag, 32, Integer_DataType,
-		new ExprInfo(Null_Code, Operands(DblDbl), AssocCode2(Gt, 2))
+		Null_Flag, 32, Integer_DataType, &Gt_ExprInfo
 	},
 	{	// GtEq_Code
 		Operator_TokenType, TwoChar_Multiple,
 		">=", NULL, NULL,
-		Null_Flag, 32, Integer_DataType,
-		new ExprInfo(Null_Code, Operands(DblDbl), AssocCode2(GtEq, 2))
+		Null_Flag, 32, Integer_DataType, &GtEq_ExprInfo
 	},
 	{	// Lt_Code
 		Operator_TokenType, TwoChar_Multiple,
 		"<", NULL, NULL,
-		Null_Flag, 32, Integer_DataType,
-		new ExprInfo(Null_Code, Operands(DblDbl), AssocCode2(Lt, 2))
+		Null_Flag, 32, Integer_DataType, &Lt_ExprInfo
 	},
 	{	// LtEq_Code
 		Operator_TokenType, TwoChar_Multiple,
 		"<=", NULL, NULL,
-		Null_Flag, 32, Integer_DataType,
-		new ExprInfo(Null_Code, Operands(DblDbl), AssocCode2(LtEq, 2))
+		Null_Flag, 32, Integer_DataType, &LtEq_ExprInfo
 	},
 	{	// NotEq_Code
 		Operator_TokenType, TwoChar_Multiple,
 		"<>", NULL, NULL,
-		Null_Flag, 30, Integer_DataType,
-		new ExprInfo(Null_Code, Operands(DblDbl), AssocCode2(NotEq, 2))
+		Null_Flag, 30, Integer_DataType, &NotEq_ExprInfo
 	},
 	{	// OpenParen_Code
 		Operator_TokenType, OneChar_Multiple,
@@ -769,17 +909,20 @@ static TableEntry tableEntries[] =
 	{	// CloseParen_Code
 		Operator_TokenType, OneChar_Multiple,
 		")", NULL, NULL,
-		Null_Flag, 4, None_DataType
+		Null_Flag, 4, None_DataType,
+		NULL, NULL, NULL, NULL, NULL, parenRecreate
 	},
 	{	// Comma_Code
 		Operator_TokenType, OneChar_Multiple,
 		",", NULL, NULL,
-		Null_Flag, 6, None_DataType
+		Null_Flag, 6, None_DataType,
+		NULL, NULL, NULL, NULL, NULL, printCommaRecreate
 	},
 	{	// SemiColon_Code
 		Operator_TokenType, OneChar_Multiple,
 		";", NULL, NULL,
-		Null_Flag, 6, None_DataType
+		Null_Flag, 6, None_DataType,
+		NULL, NULL, NULL, NULL, NULL, printSemicolonRecreate
 	},
 	{	// Colon_Code
 		Operator_TokenType, OneChar_Multiple,
@@ -790,7 +933,7 @@ static TableEntry tableEntries[] =
 		Operator_TokenType, OneChar_Multiple,
 		"'", NULL, NULL,
 		EndStmt_Flag | HasOperand_Flag, 2, None_DataType, NULL,
-		NULL, remEncode, remOperandText, remRemove
+		NULL, remEncode, remOperandText, remRemove, remOpRecreate
 	},
 	//*****************
 	//   END SYMBOLS
@@ -805,95 +948,97 @@ static TableEntry tableEntries[] =
 		Operator_TokenType, OneWord_Multiple,
 		// FIXME temporarily replaced "-" with "Neq" for testing
 		"-", "Neg", NULL,
-		UseConstAsIs_Flag, 48, Double_DataType,
-		new ExprInfo(Neg_Code, Operands(Dbl), AssocCode(Neg))
+		UseConstAsIs_Flag, 48, Double_DataType, &Neg_ExprInfo
 	},
 	{	// Assign_Code
 		Operator_TokenType, OneWord_Multiple,
 		"=", "Assign", "LET",
-		Reference_Flag, 4, Double_DataType,
-		new ExprInfo(Null_Code, Operands(DblDbl), AssocCode2(Assign, 2))
+		Reference_Flag, 4, Double_DataType, &Assign_ExprInfo,
+		NULL, NULL, NULL, NULL, assignRecreate
 	},
 	{	// AssignInt_Code
 		Operator_TokenType, OneWord_Multiple,
 		"=", "Assign%", "LET",
-		Reference_Flag, 4, Integer_DataType,
-		new ExprInfo(Null_Code, Operands(IntInt), AssocCode(AssignInt))
+		Reference_Flag, 4, Integer_DataType, &AssignInt_ExprInfo,
+		NULL, NULL, NULL, NULL, assignRecreate
 	},
 	{	// AssignStr_Code
 		Operator_TokenType, OneWord_Multiple,
 		"=", "Assign$", "LET",
-		Reference_Flag, 4, String_DataType,
-		new ExprInfo(Null_Code, Operands(StrStr), AssocCode2(AssignStr, 1))
+		Reference_Flag, 4, String_DataType, &AssignStr_ExprInfo,
+		NULL, NULL, NULL, NULL, assignRecreate
 	},
 	{	// AssignLeft_Code
 		Operator_TokenType, OneWord_Multiple,
 		"LEFT$(", "AssignLeft", "LET",
-		Reference_Flag, 4, String_DataType,
-		new ExprInfo(Null_Code, Operands(StrStr), AssocCode(AssignLeft))
+		Reference_Flag, 4, String_DataType, &AssignLeft_ExprInfo,
+		NULL, NULL, NULL, NULL, assignRecreate
 	},
 	{	// AssignMid2_Code
 		Operator_TokenType, OneWord_Multiple,
 		"MID$(", "AssignMid2", "LET",
-		Reference_Flag, 4, String_DataType,
-		new ExprInfo(Null_Code, Operands(StrStr), AssocCode(AssignMid2))
+		Reference_Flag, 4, String_DataType, &AssignMid2_ExprInfo,
+		NULL, NULL, NULL, NULL, assignRecreate
 	},
 	{	// AssignMid3_Code
 		Operator_TokenType, OneWord_Multiple,
 		"MID$(", "AssignMid3", "LET",
-		Reference_Flag, 4, String_DataType,
-		new ExprInfo(Null_Code, Operands(StrStr), AssocCode(AssignMid3))
+		Reference_Flag, 4, String_DataType, &AssignMid3_ExprInfo,
+		NULL, NULL, NULL, NULL, assignRecreate
 	},
 	{	// AssignRight_Code
 		Operator_TokenType, OneWord_Multiple,
-		"MID$(", "AssignRight", "LET",
-		Reference_Flag, 4, String_DataType,
-		new ExprInfo(Null_Code, Operands(StrStr), AssocCode(AssignRight))
+		"RIGHT$(", "AssignRight", "LET",
+		Reference_Flag, 4, String_DataType, &AssignRight_ExprInfo,
+		NULL, NULL, NULL, NULL, assignRecreate
 	},
 	{	// AssignList_Code
 		Operator_TokenType, OneWord_Multiple,
 		"=", "AssignList", "LET",
-		Reference_Flag, 4, Double_DataType, &DblDbl_ExprInfo
+		Reference_Flag, 4, Double_DataType, &DblDbl_ExprInfo,
+		NULL, NULL, NULL, NULL, assignRecreate
 	},
 	{	// AssignListInt_Code
 		Operator_TokenType, OneWord_Multiple,
 		"=", "AssignList%", "LET",
-		Reference_Flag, 4, Integer_DataType,
-		&IntInt_ExprInfo
+		Reference_Flag, 4, Integer_DataType, &IntInt_ExprInfo,
+		NULL, NULL, NULL, NULL, assignRecreate
 	},
 	{	// AssignListStr_Code
 		Operator_TokenType, OneWord_Multiple,
 		"=", "AssignList$", "LET",
-		Reference_Flag, 4, String_DataType, &StrStr_ExprInfo
+		Reference_Flag, 4, String_DataType, &StrStr_ExprInfo,
+		NULL, NULL, NULL, NULL, assignRecreate
 	},
 	{	// AssignKeepStr_Code
 		Operator_TokenType, OneWord_Multiple,
 		"=", "AssignKeep$", "LET",
-		Reference_Flag, 4, String_DataType, &StrStr_ExprInfo
+		Reference_Flag, 4, String_DataType, &StrStr_ExprInfo,
+		NULL, NULL, NULL, NULL, assignKeepRecreate
 	},
 	{	// AssignKeepLeft_Code
 		Operator_TokenType, OneWord_Multiple,
 		"LEFT$(", "AssignKeepLeft", "LET",
-		Reference_Flag, 4, String_DataType,
-		&StrStr_ExprInfo
+		Reference_Flag, 4, String_DataType, &StrStr_ExprInfo,
+		NULL, NULL, NULL, NULL, assignKeepRecreate
 	},
 	{	// AssignKeepMid2_Code
 		Operator_TokenType, OneWord_Multiple,
 		"MID$(", "AssignKeepMid2", "LET",
-		Reference_Flag, 4, String_DataType,
-		&StrStr_ExprInfo
+		Reference_Flag, 4, String_DataType, &StrStr_ExprInfo,
+		NULL, NULL, NULL, NULL, assignKeepRecreate
 	},
 	{	// AssignKeepMid3_Code
 		Operator_TokenType, OneWord_Multiple,
 		"MID$(", "AssignKeepMid3", "LET",
-		Reference_Flag, 4, String_DataType,
-		&StrStr_ExprInfo
+		Reference_Flag, 4, String_DataType, &StrStr_ExprInfo,
+		NULL, NULL, NULL, NULL, assignKeepRecreate
 	},
 	{	// AssignKeepRight_Code
 		Operator_TokenType, OneWord_Multiple,
 		"RIGHT$(", "AssignKeepRight", "LET",
-		Reference_Flag, 4, String_DataType,
-		&StrStr_ExprInfo
+		Reference_Flag, 4, String_DataType, &StrStr_ExprInfo,
+		NULL, NULL, NULL, NULL, assignKeepRecreate
 	},
 	{	// EOL_Code
 		Operator_TokenType, OneWord_Multiple,
@@ -913,8 +1058,7 @@ static TableEntry tableEntries[] =
 	{	// AddInt_Code
 		Operator_TokenType, OneChar_Multiple,
 		"+", "+%", NULL,
-		Null_Flag, 40, Integer_DataType,
-		new ExprInfo(Null_Code, Operands(IntInt), AssocCode(AddInt))
+		Null_Flag, 40, Integer_DataType, &AddInt_ExprInfo
 	},
 	{	// CatStr_Code
 		Operator_TokenType, OneChar_Multiple,
@@ -934,14 +1078,12 @@ static TableEntry tableEntries[] =
 	{	// SubInt_Code
 		Operator_TokenType, OneChar_Multiple,
 		"-", "-%", NULL,
-		Null_Flag, 40, Integer_DataType,
-		new ExprInfo(Null_Code, Operands(IntInt), AssocCode(SubInt))
+		Null_Flag, 40, Integer_DataType, &SubInt_ExprInfo
 	},
 	{	// NegInt_Code
 		Operator_TokenType, OneChar_Multiple,
 		"-", "Neg%", NULL,
-		Null_Flag, 40, Integer_DataType,
-		new ExprInfo(NegInt_Code, Operands(Int))
+		Null_Flag, 40, Integer_DataType, &NegInt_ExprInfo
 	},
 	{	// MulI1_Code
 		Operator_TokenType, OneChar_Multiple,
@@ -956,8 +1098,7 @@ static TableEntry tableEntries[] =
 	{	// MulInt_Code
 		Operator_TokenType, OneChar_Multiple,
 		"*", "*%", NULL,
-		Null_Flag, 46, Integer_DataType,
-		new ExprInfo(Null_Code, Operands(IntInt), AssocCode(MulInt))
+		Null_Flag, 46, Integer_DataType, &MulInt_ExprInfo
 	},
 	{	// DivI1_Code
 		Operator_TokenType, OneChar_Multiple,
@@ -972,8 +1113,7 @@ static TableEntry tableEntries[] =
 	{	// DivInt_Code
 		Operator_TokenType, OneChar_Multiple,
 		"/", "/%", NULL,
-		Null_Flag, 46, Integer_DataType,
-		new ExprInfo(Null_Code, Operands(IntInt), AssocCode(DivInt))
+		Null_Flag, 46, Integer_DataType, &DivInt_ExprInfo
 	},
 	{	// ModI1_Code
 		Operator_TokenType, OneChar_Multiple,
@@ -988,8 +1128,7 @@ static TableEntry tableEntries[] =
 	{	// ModInt_Code
 		Operator_TokenType, OneWord_Multiple,
 		"MOD", "MOD%", NULL,
-		Null_Flag, 42, Integer_DataType,
-		new ExprInfo(Null_Code, Operands(IntInt), AssocCode(ModInt))
+		Null_Flag, 42, Integer_DataType, &ModInt_ExprInfo
 	},
 	{	// PowerI1_Code
 		Operator_TokenType, OneChar_Multiple,
@@ -1004,8 +1143,7 @@ static TableEntry tableEntries[] =
 	{	// PowerInt_Code
 		Operator_TokenType, OneChar_Multiple,
 		"^", "^%", NULL,
-		Null_Flag, 50, Integer_DataType,
-		new ExprInfo(Null_Code, Operands(IntInt), AssocCode(PowerInt))
+		Null_Flag, 50, Integer_DataType, &PowerInt_ExprInfo
 	},
 	{	// EqI1_Code
 		Operator_TokenType, OneChar_Multiple,
@@ -1020,8 +1158,7 @@ static TableEntry tableEntries[] =
 	{	// EqInt_Code
 		Operator_TokenType, OneChar_Multiple,
 		"=", "=%", NULL,
-		Null_Flag, 30, Integer_DataType,
-		new ExprInfo(Null_Code, Operands(IntInt), AssocCode(EqInt))
+		Null_Flag, 30, Integer_DataType, &EqInt_ExprInfo
 	},
 	{	// EqStr_Code
 		Operator_TokenType, OneChar_Multiple,
@@ -1041,8 +1178,7 @@ static TableEntry tableEntries[] =
 	{	// GtInt_Code
 		Operator_TokenType, OneChar_Multiple,
 		">", ">%", NULL,
-		Null_Flag, 32, Integer_DataType,
-		new ExprInfo(Null_Code, Operands(IntInt), AssocCode(GtInt))
+		Null_Flag, 32, Integer_DataType, &GtInt_ExprInfo
 	},
 	{	// GtStr_Code
 		Operator_TokenType, OneChar_Multiple,
@@ -1062,8 +1198,7 @@ static TableEntry tableEntries[] =
 	{	// GtEqInt_Code
 		Operator_TokenType, OneChar_Multiple,
 		">=", ">=%", NULL,
-		Null_Flag, 32, Integer_DataType,
-		new ExprInfo(Null_Code, Operands(IntInt), AssocCode(GtEqInt))
+		Null_Flag, 32, Integer_DataType, &GtEqInt_ExprInfo
 	},
 	{	// GtEqStr_Code
 		Operator_TokenType, OneChar_Multiple,
@@ -1083,8 +1218,7 @@ static TableEntry tableEntries[] =
 	{	// LtInt_Code
 		Operator_TokenType, OneChar_Multiple,
 		"<", "<%", NULL,
-		Null_Flag, 32, Integer_DataType,
-		new ExprInfo(Null_Code, Operands(IntInt), AssocCode(LtInt))
+		Null_Flag, 32, Integer_DataType, &LtInt_ExprInfo
 	},
 	{	// LtStr_Code
 		Operator_TokenType, OneChar_Multiple,
@@ -1104,8 +1238,7 @@ static TableEntry tableEntries[] =
 	{	// LtEqInt_Code
 		Operator_TokenType, OneChar_Multiple,
 		"<=", "<=%", NULL,
-		Null_Flag, 32, Integer_DataType,
-		new ExprInfo(Null_Code, Operands(IntInt), AssocCode(LtEqInt))
+		Null_Flag, 32, Integer_DataType, &LtEqInt_ExprInfo
 	},
 	{	// LtEqStr_Code
 		Operator_TokenType, OneChar_Multiple,
@@ -1125,8 +1258,7 @@ static TableEntry tableEntries[] =
 	{	// NotEqInt_Code
 		Operator_TokenType, OneChar_Multiple,
 		"<>", "<>%", NULL,
-		Null_Flag, 30, Integer_DataType,
-		new ExprInfo(Null_Code, Operands(IntInt), AssocCode(NotEqInt))
+		Null_Flag, 30, Integer_DataType, &NotEqInt_ExprInfo
 	},
 	{	// NotEqStr_Code
 		Operator_TokenType, OneChar_Multiple,
@@ -1158,6 +1290,12 @@ static TableEntry tableEntries[] =
 		NULL, "CvtDbl", NULL,
 		Hidden_Flag, 2, None_DataType
 	},
+	{	// CatStrs_Code
+		IntFuncN_TokenType, OneWord_Multiple,
+		NULL, "CatStrs", NULL,
+		Hidden_Flag | HasOperand_Flag, 40, None_DataType, NULL,
+		NULL, catStrsEncode, catStrsOperandText, NULL, catStrsRecreate
+	},
 	{	// StrInt_Code
 		IntFuncP_TokenType, OneWord_Multiple,
 		"STR$(", "STR%$(", NULL,
@@ -1166,18 +1304,27 @@ static TableEntry tableEntries[] =
 	{	// PrintDbl_Code
 		IntFuncN_TokenType, OneWord_Multiple,
 		NULL, "PrintDbl", NULL,
-		Print_Flag | UseConstAsIs_Flag, 2, None_DataType,
-		new ExprInfo(Null_Code, Operands(Dbl), AssocCode(Print))
+		Print_Flag | UseConstAsIs_Flag, 2, None_DataType, &PrintDbl_ExprInfo,
+		NULL, NULL, NULL, NULL, printItemRecreate
 	},
 	{	// PrintInt_Code
 		IntFuncN_TokenType, OneWord_Multiple,
 		NULL, "PrintInt", NULL,
-		Print_Flag, 2, None_DataType, &Int_ExprInfo
+		Print_Flag, 2, None_DataType, &Int_ExprInfo,
+		NULL, NULL, NULL, NULL, printItemRecreate
 	},
 	{	// PrintStr_Code
 		IntFuncN_TokenType, OneWord_Multiple,
 		NULL, "PrintStr", NULL,
-		Print_Flag, 2, None_DataType, &Str_ExprInfo
+		Print_Flag, 2, None_DataType, &Str_ExprInfo,
+		NULL, NULL, NULL, NULL, printItemRecreate
+	},
+	{	// PrintConst_Code
+		IntFuncN_TokenType, OneWord_Multiple,
+		NULL, "PrintConst", NULL,
+		Print_Flag | HasOperand_Flag, 2, None_DataType, NULL,
+		NULL, printConstEncode, printConstOperandText, printConstRemove,
+		printConstRecreate
 	},
 	{	// InputBegin_Code
 		IntFuncN_TokenType, OneWord_Multiple,
@@ -1187,26 +1334,26 @@ static TableEntry tableEntries[] =
 	{	// InputBeginStr_Code
 		IntFuncN_TokenType, OneWord_Multiple,
 		NULL, "InputBeginStr", "Question",
-		Null_Flag, 2, None_DataType,
-		new ExprInfo(Null_Code, Operands(Str))
+		Null_Flag, 2, None_DataType, &InputBeginStr_ExprInfo,
+		NULL, NULL, NULL, NULL, inputPromptBeginRecreate
 	},
 	{	// InputAssign_Code
 		IntFuncN_TokenType, OneWord_Multiple,
 		NULL, "InputAssign", NULL,
-		Reference_Flag, 2, None_DataType,
-		new ExprInfo(Null_Code, Operands(Dbl), AssocCode2(InputAssign, 2))
+		Reference_Flag, 2, None_DataType, &InputAssign_ExprInfo,
+		NULL, NULL, NULL, NULL, inputAssignRecreate
 	},
 	{	// InputAssignInt_Code
 		IntFuncN_TokenType, OneWord_Multiple,
 		NULL, "InputAssignInt", NULL,
-		Reference_Flag, 2, None_DataType,
-		new ExprInfo(Null_Code, Operands(Int), AssocCode(InputAssignInt))
+		Reference_Flag, 2, None_DataType, &InputAssignInt_ExprInfo,
+		NULL, NULL, NULL, NULL, inputAssignRecreate
 	},
 	{	// InputAssignStr_Code
 		IntFuncN_TokenType, OneWord_Multiple,
 		NULL, "InputAssignStr", NULL,
-		Reference_Flag, 2, None_DataType,
-		new ExprInfo(Null_Code, Operands(Str), AssocCode(InputAssignStr))
+		Reference_Flag, 2, None_DataType, &InputAssignStr_ExprInfo,
+		NULL, NULL, NULL, NULL, inputAssignRecreate
 	},
 	{	// InputParse_Code
 		IntFuncN_TokenType, OneWord_Multiple,
@@ -1226,8 +1373,7 @@ static TableEntry tableEntries[] =
 	{	// Const_Code
 		Constant_TokenType, OneWord_Multiple,
 		NULL, "Const", NULL,
-		HasOperand_Flag, 2, Double_DataType,
-		new ExprInfo(Null_Code, Operands(Dbl), AssocCode(Const)),
+		HasOperand_Flag, 2, Double_DataType, &Const_ExprInfo,
 		NULL, constNumEncode, constNumOperandText, constNumRemove
 	},
 	{	// ConstInt_Code
@@ -1240,13 +1386,25 @@ static TableEntry tableEntries[] =
 		Constant_TokenType, OneWord_Multiple,
 		NULL, "ConstStr", NULL,
 		HasOperand_Flag, 2, String_DataType, &Str_ExprInfo,
-		NULL, constStrEncode, constStrOperandText, constStrRemove
+		NULL, constStrEncode, constStrOperandText, constStrRemove,
+		constStrRecreate
+	},
+	{	// ConstImm_Code
+		Constant_TokenType, OneWord_Multiple,
+		NULL, "ConstImm", NULL,
+		HasOperand_Flag, 2, Double_DataType, &Dbl_ExprInfo,
+		NULL, NULL, constImmOperandText, NULL
+	},
+	{	// ConstIntImm_Code
+		Constant_TokenType, OneWord_Multiple,
+		NULL, "ConstIntImm", NULL,
+		HasOperand_Flag, 2, Integer_DataType, &Int_ExprInfo,
+		NULL, NULL, constImmOperandText, NULL
 	},
 	{	// Var_Code
 		NoParen_TokenType, OneWord_Multiple,
 		NULL, "Var", NULL,
-		HasOperand_Flag, 2, Double_DataType,
-		new ExprInfo(Null_Code, Operands(Dbl), AssocCode(Var)),
+		HasOperand_Flag, 2, Double_DataType, &Var_ExprInfo,
 		NULL, varDblEncode, varDblOperandText, varDblRemove
 	},
 	{	// VarInt_Code
@@ -1264,8 +1422,7 @@ static TableEntry tableEntries[] =
 	{	// VarRef_Code
 		NoParen_TokenType, OneWord_Multiple,
 		NULL, "VarRef", NULL,
-		HasOperand_Flag | Reference_Flag, 2, Double_DataType,
-		new ExprInfo(Null_Code, Operands(Dbl), AssocCode(VarRef)),
+		HasOperand_Flag | Reference_Flag, 2, Double_DataType, &VarRef_ExprInfo,
 		NULL, varDblEncode, varDblOperandText, varDblRemove
 	},
 	{	// VarRefInt_Code
@@ -1283,98 +1440,136 @@ static TableEntry tableEntries[] =
 };
 
 
-// function to create the single instance of the table
+// range of codes for each search type (begin and end codes not included)
+static const struct SearchRange
+{
+	Code beg;						// begin index of range
+	Code end;						// end index of range
+} searchRange[sizeof_SearchType] = {
+	{BegPlainWord_Code, EndPlainWord_Code},
+	{BegParenWord_Code, EndParenWord_Code},
+	{BegDataTypeWord_Code, EndDataTypeWord_Code},
+	{BegSymbol_Code, EndSymbol_Code}
+};
+
+
+// function to search for the code with an operand of a data type
 //
-//   - creates the single table instance with the table entries
-//   - fatally aborts if called more than once
-//   - returns list of errors if any detected during initialization
-//   - returns empty list upon successful initialization
-//   - will not allow an second instance to be created
+//   - if the data type matches the operand of the code, returns the code
+//   - else the associated codes of the code for the operand are searched
+//     (the first operand associated codes are before the second index)
+//   - returns Invalid_Code if no code found
 
-void Table::initialize(void)
+Code Table::resolveCode(Code code, int operandIndex,
+	DataType dataType) const
 {
-	if (s_instance != NULL || !s_errorList.isEmpty())
+	const ExprInfo *exprInfo = tableEntries[code].exprInfo;
+	if (exprInfo == NULL || operandIndex >= exprInfo->m_operandCount)
 	{
-		qFatal("Only one Table instance may be created!");
+		return Invalid_Code;  // code does not have the operand
 	}
-	s_instance = new Table(tableEntries);
-
-	s_errorList = s_instance->setupAndCheck();
-	if (!s_errorList.isEmpty())
+	if (dataType == exprInfo->m_operandDataType[operandIndex])
 	{
-		delete s_instance;
-		s_instance = NULL;
+		return code;
 	}
-}
-
-
-// static function to return a refernce to the single table instance
-//
-//   - fatally aborts if table entry errors were detected
-//   - fatally aborts if called before the instance is created
 
-Table &Table::instance(void)
-{
-	if (!s_errorList.isEmpty())
+	// if second index -1, then no associated codes to search
+	int i = exprInfo->m_secondAssociatedIndex;
+	if (i < 0)
 	{
-		qFatal("Table entry errors were detected!");
+		return Invalid_Code;
 	}
-	if (s_instance == NULL)
+	// determine range of associated codes to search
+	int end = exprInfo->m_associatedCodeCount;
+	if (operandIndex == 0 && i != 0)  // first operand?
 	{
-		qFatal("Table instance was not created!");
+		// if first operand and there are second operand associated codes
+		// then set end to start of second operand associated codes
+		// and start to first associated code
+		end = i;
+		i = 0;
 	}
-	return *s_instance;
-}
-
-
-// static function that checks if any table entries were detected
-//
-//   - fatally aborts if called before instance creation was attempted
-
-bool Table::hasErrors(void)
-{
-	if (s_instance == NULL && s_errorList.isEmpty())
+	for (; i < end; i++)
 	{
-		qFatal("Table initialization was not attempted!");
+		Code assocCode = exprInfo->m_associatedCode[i];
+		const ExprInfo *exprInfo2 = tableEntries[assocCode].exprInfo;
+		if (exprInfo2 != NULL && operandIndex < exprInfo2->m_operandCount
+			&& dataType == exprInfo2->m_operandDataType[operandIndex])
+		{
+			return assocCode;
+		}
 	}
-	return !s_errorList.isEmpty();
+	return Invalid_Code;  // did not find an associated code for data type
 }
 
 
-// static function that returns list of table errors detected
-//
-//   - fatally aborts if called before instance creation was attempted
-
-QStringList Table::errorList(void)
-{
-	if (s_instance == NULL && s_errorList.isEmpty())
-	{
-		qFatal("Table initialization was not attempted!");
-	}
-	return s_errorList;
-}
+// dense arrays of the code attributes needed for every token (generated
+// from the table entries, see the check function)
+#include "autotable.h"
 
 
-// function that initializes the table variables
+// function that checks the table entries
 //
+//   - the expected data type of each expression information structure is
+//     checked against the one determined from its operand data types and
+//     the data types of its secondary associated codes
 //   - if any error found then list of error messages returned
 //   - an empty list is returned if no errors were detected
 
-QStringList Table::setupAndCheck(void)
+QStringList Table::check(void) const
 {
 	QStringList errorList;
 	int i;
 	int type;
 
-	// scan table and record indexes
+	// scan table entries
 	int entryCount = sizeof(tableEntries) / sizeof(TableEntry);
+	if (entryCount != sizeof_Code)
+	{
+		errorList.append(QString("Entry count %1 does not match code count "
+			"%2").arg(entryCount).arg(sizeof_Code));
+	}
 	// find maximum number of operands and associated codes
 	int maxOperands = 0;
 	int maxAssocCodes = 0;
 	for (i = 0; i < entryCount; i++)
 	{
+		// check precedence (must fit in the precedence array)
+		if (tableEntries[i].precedence >= HighestPrecedence)
+		{
+			errorList.append(QString("Entry:%1 Precedence=%2 too large, "
+				"maximum is %3").arg(i).arg(tableEntries[i].precedence)
+				.arg(HighestPrecedence - 1));
+		}
+
+		// check the attributes of the dense arrays (from enums.awk)
+		const TableEntry &entry = tableEntries[i];
+		if (i < sizeof_Code && (s_type[i] != entry.type
+			|| s_dataType[i] != entry.dataType || s_flags[i] != entry.flags
+			|| s_precedence[i] != entry.precedence
+			|| s_operandCount[i] != (entry.exprInfo == NULL ? 0
+			: entry.exprInfo->m_operandCount)))
+		{
+			errorList.append(QString("Entry:%1 Attributes do not match "
+				"code attribute arrays").arg(i));
+		}
+		// check the resolved codes (from enums.awk) against the search
+		for (int index = 0; i < sizeof_Code && index < MaxOperands; index++)
+		{
+			for (type = 0; type < sizeof_DataType; type++)
+			{
+				if (s_resolvedCode[i][index][type] != resolveCode((Code)i,
+					index, (DataType)type))
+				{
+					errorList.append(QString("Entry:%1 Operand:%2 DataType:%3 "
+						"resolved code does not match").arg(i).arg(index)
+						.arg(type));
+				}
+			}
+		}
+
 		// check if found new maximums
-		ExprInfo *exprInfo = m_entry[i].exprInfo;
+		const ExprInfo *exprInfo = tableEntries[i].exprInfo;
 		if (exprInfo != NULL)
 		{
 			if (maxOperands < exprInfo->m_operandCount)
@@ -1398,25 +1593,26 @@ QStringList Table::setupAndCheck(void)
 			}
 
 			// validate multiple entries
-			if (m_entry[i].flags & Multiple_Flag != 0)
+			if (tableEntries[i].flags & Multiple_Flag)
 			{
-				ExprInfo *exprInfo2 = m_entry[i + 1].exprInfo;
-				if (m_entry[i].name != m_entry[i + 1].name)
+				const ExprInfo *exprInfo2 = tableEntries[i + 1].exprInfo;
+				if (qstrcmp(tableEntries[i].name, tableEntries[i + 1].name)
+					!= 0)
 				{
 					errorList.append(QString("Multiple entry '%1' name "
-						"mis-match '%2'").arg(m_entry[i].name)
-						.arg(m_entry[i + 1].name));
+						"mis-match '%2'").arg(tableEntries[i].name)
+						.arg(tableEntries[i + 1].name));
 				}
 				else if (exprInfo2 == NULL)
 				{
 					errorList.append(QString("Multiple entry '%1' next entry "
-						"no expression info").arg(m_entry[i + 1].name));
+						"no expression info").arg(tableEntries[i + 1].name));
 				}
 				else if (exprInfo2->m_operandCount
 					!= exprInfo->m_operandCount + 1)
 				{
 					errorList.append(QString("Multiple entry '%1' incorrect "
-						"number of operands (%2, %3)").arg(m_entry[i].name)
+						"number of operands (%2, %3)").arg(tableEntries[i].name)
 						.arg(exprInfo->m_operandCount)
 						.arg(exprInfo2->m_operandCount));
 				}
@@ -1435,24 +1631,26 @@ QStringList Table::setupAndCheck(void)
 				Str_BitMask		// String
 			};
 
-			// set expected data type (start with data type of last operand)
+			// determine expected data type (start with data type of operand)
+			DataType expectedDataType = None_DataType;
 			if (exprInfo->m_operandCount > 0)
 			{
 				// use last operand for operators, first operand for functions
-				exprInfo->m_expectedDataType
-					= exprInfo->m_operandDataType[m_entry[i].type
-					== Operator_TokenType ? exprInfo->m_operandCount - 1 : 0];
+				expectedDataType = exprInfo->m_operandDataType[tableEntries[i]
+					.type == Operator_TokenType ? exprInfo->m_operandCount - 1
+					: 0];
 				// check each secondary associated code
 				if (exprInfo->m_associatedCodeCount > 0)
 				{
-					int bitMask = bitMaskDataType[exprInfo->m_expectedDataType];
+					int bitMask = bitMaskDataType[expectedDataType];
 					int index = exprInfo->m_secondAssociatedIndex;
 					if (index >= 0)
 					{
 						for (; index < exprInfo->m_associatedCodeCount; index++)
 						{
 							Code assocCode = exprInfo->m_associatedCode[index];
-							ExprInfo *exprInfo2 = m_entry[assocCode].exprInfo;
+							const ExprInfo *exprInfo2
+								= tableEntries[assocCode].exprInfo;
 							if (exprInfo2 != NULL)
 							{
 								bitMask |= bitMaskDataType[exprInfo2
@@ -1462,15 +1660,21 @@ QStringList Table::setupAndCheck(void)
 						}
 						if (bitMask == Num_BitMask)
 						{
-							exprInfo->m_expectedDataType = Number_DataType;
+							expectedDataType = Number_DataType;
 						}
 						else if (bitMask == Any_BitMask)
 						{
-							exprInfo->m_expectedDataType = Any_DataType;
+							expectedDataType = Any_DataType;
 						}
 					}
 				}
 			}
+			if (exprInfo->m_expectedDataType != expectedDataType)
+			{
+				errorList.append(QString("Entry:%1 expected data type %2 "
+					"incorrect, should be %3").arg(i)
+					.arg(exprInfo->m_expectedDataType).arg(expectedDataType));
+			}
 		}
 	}
 
@@ -1486,45 +1690,30 @@ QStringList Table::setupAndCheck(void)
 			.arg(MaxAssocCodes).arg(maxAssocCodes));
 	}
 
-	// setup indexes for bracketing codes
-	// (will be set to -1 if missing - missing errors were recorded above)
-	m_range[PlainWord_SearchType].beg = BegPlainWord_Code;
-	m_range[PlainWord_SearchType].end = EndPlainWord_Code;
-	m_range[ParenWord_SearchType].beg = BegParenWord_Code;
-	m_range[ParenWord_SearchType].end = EndParenWord_Code;
-	m_range[DataTypeWord_SearchType].beg = BegDataTypeWord_Code;
-	m_range[DataTypeWord_SearchType].end = EndDataTypeWord_Code;
-	m_range[Symbol_SearchType].beg = BegSymbol_Code;
-	m_range[Symbol_SearchType].end = EndSymbol_Code;
-
-	// check for missing bracketing codes and if properly positioned in table
-	// (missing codes recorded above, however,
-	// need to make sure all types were set, i.e. no missing assignments above)
+	// check if bracketing codes are properly positioned in table
 	for (type = 0; type < sizeof_SearchType; type++)
 	{
-		if (m_range[type].beg > m_range[type].end)
+		const SearchRange &range = searchRange[type];
+		if (range.beg > range.end)
 		{
 			// record bracket range error
 			errorList.append(QString("Search type %1 indexes (%2, %3) not "
-				"correct").arg(type).arg(m_range[type].beg)
-				.arg(m_range[type].end));
+				"correct").arg(type).arg(range.beg).arg(range.end));
 		}
 		else
 		{
 			// check to make sure no bracketing codes overlap
 			for (int type2 = 0; type2 < sizeof_SearchType; type2++)
 			{
+				const SearchRange &range2 = searchRange[type2];
 				if (type != type2
-					&& (m_range[type].beg > m_range[type2].beg
-					&& m_range[type].beg < m_range[type2].end
-					|| m_range[type].end > m_range[type2].beg
-					&& m_range[type].end < m_range[type2].end))
+					&& (range.beg > range2.beg && range.beg < range2.end
+					|| range.end > range2.beg && range.end < range2.end))
 				{
 					// record bracket overlap error
 					errorList.append(QString("Search type %1 indexes (%2, %3) "
 						"overlap with search type %4").arg(type)
-						.arg(m_range[type].beg).arg(m_range[type].end)
-						.arg(type2));
+						.arg(range.beg).arg(range.end).arg(type2));
 				}
 			}
 		}
@@ -1535,140 +1724,139 @@ QStringList Table::setupAndCheck(void)
 }
 
 
-//================================
-//  CODE RELATED TABLE FUNCTIONS
-//================================
+// function that calculates the signature of the codes of the table
+// (FNV-1a hash of the entries that determine program code), which is
+// used for validating program images
 
-// returns token type for code
-TokenType Table::type(Code code) const
+quint32 Table::signature(void) const
 {
-	return m_entry[code].type;
+	quint32 signature = 2166136261u;
+	int entryCount = sizeof(tableEntries) / sizeof(TableEntry);
+	for (int i = 0; i < entryCount; i++)
+	{
+		QString string = QString("%1,%2,%3,%4;").arg(tableEntries[i].type)
+			.arg(tableEntries[i].dataType).arg(tableEntries[i].flags)
+			.arg(debugName((Code)i));
+		for (int j = 0; j < string.length(); j++)
+		{
+			signature ^= string.at(j).unicode();
+			signature *= 16777619u;
+		}
+	}
+	return signature;
 }
 
-// returns data type for code
-DataType Table::dataType(Code code) const
-{
-	return m_entry[code].dataType;
-}
+
+//================================
+//  CODE RELATED TABLE FUNCTIONS
+//================================
 
 // returns multiple word or character type for code
 Multiple Table::multiple(Code code) const
 {
-	return m_entry[code].multiple;
+	return tableEntries[code].multiple;
 }
 
 // returns primary name for code
 const QString Table::name(Code code) const
 {
-	return m_entry[code].name;
+	return tableEntries[code].name;
 }
 
 // returns second name of a two word command for code
 const QString Table::name2(Code code) const
 {
-	return m_entry[code].name2;
+	return tableEntries[code].name2;
 }
 
 const QString Table::optionName(Code code) const
 {
-	return m_entry[code].option;
+	return tableEntries[code].option;
 }
 
 // returns the debug name for code, which is the primary name
 // except for internal functions with multiple argument footprints
 const QString Table::debugName(Code code) const
 {
-	QString name = code == Invalid_Code ? "<NotSet>" : m_entry[code].name2;
+	QString name = code == Invalid_Code ? "<NotSet>" : tableEntries[code].name2;
 	if (name.isEmpty())
 	{
-		name = m_entry[code].name;
+		name = tableEntries[code].name;
 	}
 	return name;
 }
 
-// returns the flags for code
-int Table::hasFlag(Code code, int flag) const
-{
-	return m_entry[code].flags & flag;
-}
-
-// returns the precedence for code
-int Table::precedence(Code code) const
-{
-	return m_entry[code].precedence;
-}
-
-// returns the number of operators (arguments) for code
-int Table::operandCount(Code code) const
-{
-	return m_entry[code].exprInfo->m_operandCount;
-}
-
 // returns the data type for a specific operator for code
 DataType Table::operandDataType(Code code, int operand) const
 {
-	return m_entry[code].exprInfo->m_operandDataType[operand];
+	return tableEntries[code].exprInfo->m_operandDataType[operand];
 }
 
 // returns the number of associate codes for code
 int Table::associatedCodeCount(Code code) const
 {
-	return m_entry[code].exprInfo->m_associatedCodeCount;
+	return tableEntries[code].exprInfo->m_associatedCodeCount;
 }
 
 // returns the associate code for a specific index for code
 Code Table::associatedCode(Code code, int index) const
 {
-	return m_entry[code].exprInfo->m_associatedCode[index];
+	return tableEntries[code].exprInfo->m_associatedCode[index];
 }
 
 // returns the associated code array for a code
-Code *Table::associatedCodeArray(Code code) const
+const Code *Table::associatedCodeArray(Code code) const
 {
-	return m_entry[code].exprInfo->m_associatedCode;
+	return tableEntries[code].exprInfo->m_associatedCode;
 }
 
 // returns the start index of the secondary associated codes for code
 int Table::secondAssociatedIndex(Code code) const
 {
-	return m_entry[code].exprInfo->m_secondAssociatedIndex;
+	return tableEntries[code].exprInfo->m_secondAssociatedIndex;
 }
 
 // returns the secondary associated code for a specific index for code
 Code Table::secondAssociatedCode(Code code, int index) const
 {
-	return m_entry[code].exprInfo->m_associatedCode[secondAssociatedIndex(code)
-		+ index];
+	return tableEntries[code].exprInfo
+		->m_associatedCode[secondAssociatedIndex(code) + index];
 }
 
 // returns the expected data type for last operand for operator code
 DataType Table::expectedDataType(Code code) const
 {
-	return m_entry[code].exprInfo->m_expectedDataType;
+	return tableEntries[code].exprInfo->m_expectedDataType;
 }
 
 // returns the pointer to the translate function (if any) for code
 TranslateFunction Table::translateFunction(Code code) const
 {
-	return m_entry[code].translate;
+	return tableEntries[code].translate;
 }
 
 // returns the pointer to the encode function (if any) for code
 EncodeFunction Table::encodeFunction(Code code) const
 {
-	return m_entry[code].encode;
+	return tableEntries[code].encode;
 }
 
 // returns the pointer to the operand text function (if any) for code
 OperandTextFunction Table::operandTextFunction(Code code) const
 {
-	return m_entry[code].operandText;
+	return tableEntries[code].operandText;
 }
 
 // returns the pointer to the remove function (if any) for code
 RemoveFunction Table::removeFunction(Code code) const
 {
-	return m_entry[code].remove;
+	return tableEntries[code].remove;
+}
+
+// returns the pointer to the recreate function (if any) for code
+RecreateFunction Table::recreateFunction(Code code) const
+{
+	return tableEntries[code].recreate;
 }
 
 //=================================
@@ -1680,7 +1868,7 @@ Code Table::unaryCode(Token *token) const
 {
 	if (token->isType(Operator_TokenType))
 	{
-		ExprInfo *ei = m_entry[token->code()].exprInfo;
+		const ExprInfo *ei = tableEntries[token->code()].exprInfo;
 		if (ei != NULL)
 		{
 			return ei->m_unaryCode;
@@ -1703,32 +1891,6 @@ bool Table::isUnaryOrBinaryOperator(Token *token) const
 	return token->isType(Operator_TokenType) ? operandCount(token) > 0 : false;
 }
 
-// returns the precedence of the code contained in a token
-//
-//   - the precedence is obtained from the token
-//   - if this is -1 then the precedences if obtained for the token's code
-int Table::precedence(Token *token) const
-{
-	int prec = token->precedence();
-	return prec != -1 ? prec : precedence(token->code());
-}
-
-// returns the flags of the code contained in a token
-//
-//   - returns Null_Flag is the token does not contain a code
-int Table::hasFlag(Token *token, int flag) const
-{
-	// (invalid code tokens have no flags)
-	return token->hasValidCode() ? hasFlag(token->code(), flag) : 0;
-}
-
-// returns number of operands expected for code in token token
-int Table::operandCount(Token *token) const
-{
-	ExprInfo *exprInfo = m_entry[token->code()].exprInfo;
-	return exprInfo == NULL ? 0 : exprInfo->m_operandCount;
-}
-
 // returns the expected data type for last operand for operator token
 DataType Table::expectedDataType(Token *token) const
 {
@@ -1835,45 +1997,18 @@ Code Table::findCode(Token *token, Token *operandToken, int operandIndex)
 // appropriate for the data type specified
 //
 //   - if the data type does not match the operand data type of the code,
-//     then the associated codes of the code searched for a matching code
+//     then the associated code with the data type is used (obtained from
+//     the resolved code array)
 //   - if there are no associated codes, or none is found, returns false
 //   - upon success, sets the code, type and data type of the token
 
 bool Table::setTokenCode(Token *token, Code code, DataType dataType,
 	int operandIndex)
 {
-	// first check if data type already matches data type of code
-	if (dataType != operandDataType(code, operandIndex))
+	code = s_resolvedCode[code][operandIndex][dataType];
+	if (code == Invalid_Code)
 	{
-		// if not, see if data type of any associated code matches
-		int i = secondAssociatedIndex(code);
-		if (i < 0)  // if second index -1, then no associated codes to search
-		{
-			return false;
-		}
-		// determine range of associated codes to search
-		int end = associatedCodeCount(code);
-		if (operandIndex == 0 && i != 0)  // first operand?
-		{
-			// if first operand and there are second operand associated codes
-			// then set end to start of second operand associated codes
-			// and start to first associated code
-			end = i;
-			i = 0;
-		}
-		Code *associatedCodes = associatedCodeArray(code);
-		forever
-		{
-			if (i >= end)
-			{
-				return false;  // did not find an associated code for data type
-			}
-			code = associatedCodes[i++];
-			if (dataType == operandDataType(code, operandIndex))
-			{
-				break;
-			}
-		}
+		return false;  // did not find an associated code for data type
 	}
 	// change token's code and data type to associated code
 	setToken(token, code);
@@ -1893,11 +2028,12 @@ bool Table::setTokenCode(Token *token, Code code, DataType dataType,
 
 Code Table::search(SearchType type, const QStringRef &string) const
 {
-	Code i = m_range[type].beg;
-	Code end = m_range[type].end;
+	Code i = searchRange[type].beg;
+	Code end = searchRange[type].end;
 	while (++i < end)
 	{
-		if (string.compare(m_entry[i].name, Qt::CaseInsensitive) == 0)
+		if (string.compare(QLatin1String(tableEntries[i].name),
+			Qt::CaseInsensitive) == 0)
 		{
 			return i;
 		}
@@ -1915,12 +2051,14 @@ Code Table::search(SearchType type, const QStringRef &string) const
 
 Code Table::search(const QStringRef &word1, const QStringRef &word2) const
 {
-	for (Code i = m_range[PlainWord_SearchType].beg;
-		i < m_range[PlainWord_SearchType].end; i++)
+	for (Code i = searchRange[PlainWord_SearchType].beg;
+		i < searchRange[PlainWord_SearchType].end; i++)
 	{
-		if (m_entry[i].name2 != NULL
-			&& word1.compare(m_entry[i].name, Qt::CaseInsensitive) == 0
-			&& word2.compare(m_entry[i].name2, Qt::CaseInsensitive) == 0)
+		if (tableEntries[i].name2 != NULL
+			&& word1.compare(QLatin1String(tableEntries[i].name),
+			Qt::CaseInsensitive) == 0
+			&& word2.compare(QLatin1String(tableEntries[i].name2),
+			Qt::CaseInsensitive) == 0)
 		{
 			return i;
 		}
@@ -1942,9 +2080,9 @@ Code Table::search(const QStringRef &word1, const QStringRef &word2) const
 
 Code Table::search(Code index, int argumentCount) const
 {
-	for (Code i = index + 1; m_entry[i].name != NULL; i++)
+	for (Code i = index + 1; tableEntries[i].name != NULL; i++)
 	{
-		if (m_entry[index].name == m_entry[i].name
+		if (qstrcmp(tableEntries[index].name, tableEntries[i].name) == 0
 			&& argumentCount == operandCount(i))
 		{
 			return i;
@@ -31,6 +31,24 @@
 #include "token.h"
 
 
+// highest precedence value
+enum {
+	HighestPrecedence = 127
+	// this value was selected as the highest value because it is the highest
+	// one-byte signed value (in case the precedence member is changed to a
+	// char); all precedences in the table must be below this value
+};
+
+
+// maximum number of operands
+enum {
+	MaxOperands = 3
+	// this value contains the maximum number of operands
+	// (arguments) for any operator or internal function (there are currently
+	// no internal function with more than 3 arguments)
+};
+
+
 // bit definitions for flags field
 enum TableFlag
 {
@@ -74,60 +92,95 @@ enum Multiple
 struct TableEntry;
 class Translator;
 class ProgramModel;
+class Recreator;
 
 typedef TokenStatus (*TranslateFunction)(Translator &translator,
 	Token *commandToken, Token *&token);
-typedef quint16 (*EncodeFunction)(ProgramModel *programUnit, Token *token);
+typedef quint32 (*EncodeFunction)(ProgramModel *programUnit, Token *token);
 typedef const QString (*OperandTextFunction)(const ProgramModel *programUnit,
-	quint16 operand);
-typedef void (*RemoveFunction)(ProgramModel *programUnit, quint16 operand);
+	quint32 operand);
+typedef void (*RemoveFunction)(ProgramModel *programUnit, quint32 operand);
+typedef void (*RecreateFunction)(Recreator &recreator, Code code);
+
 
+// class for accessing the table entries
+//
+//   - the table entries are constant data initialized by the compiler
+//   - the attributes of the codes needed for every token are also held in
+//     dense arrays indexed by code, which are accessed by inline functions,
+//     the arrays are generated from the table entries by enums.awk (in
+//     autotable.h) as constant data initialized by the compiler, so the
+//     table has no data to initialize at startup and can be used by the
+//     initialization of other static objects
+//   - the code with an operand of each data type (the code or one of its
+//     associated codes) is also resolved by enums.awk for each code and
+//     operand, so resolving a code is a single lookup
+//   - the table entries and the dense arrays are validated by the check
+//     function, which is called by the test program (run by the regression
+//     tests)
 
 class Table
 {
-	static Table *s_instance;		// single instance of table
-	static QStringList s_errorList;	// list of errors found during initialize
+	static Table s_instance;		// single instance of table
 
-	TableEntry *m_entry;			// pointer to table entries
-	struct Range
-	{
-		Code beg;					// begin index of range
-		Code end;					// end index of range
-	} m_range[sizeof_SearchType];	// range for each search type
+	static const TokenType s_type[sizeof_Code];	// token type of each code
+	static const DataType s_dataType[sizeof_Code];	// data type of each code
+	static const int s_flags[sizeof_Code];		// flags of each code
+	static const qint8 s_precedence[sizeof_Code];	// precedence of each code
+	static const qint8 s_operandCount[sizeof_Code];	// operands of each code
+	// code with an operand of a data type for each code and operand
+	static const Code s_resolvedCode[sizeof_Code][MaxOperands]
+		[sizeof_DataType];
+
+	// function to search the associated codes for the resolved code
+	Code resolveCode(Code code, int operandIndex, DataType dataType) const;
 
 	// these functions private to prevent multiple instances
 	Table(void) {}
-	Table(TableEntry *entry) : m_entry(entry) {}
 	Table(Table const &) {}
 	Table &operator=(Table const &) {return *this;}
 
-	// function to setup and check the table entries
-	QStringList setupAndCheck(void);
 public:
-	// function to create the single instance, initialize and check the table
-	static void initialize(void);
 	// function to return a reference to the single table instance
-	static Table &instance(void);
-	// function to report if there were any table errors
-	static bool hasErrors(void);
-	// function to returns list of table errors
-	static QStringList errorList(void);
+	static Table &instance(void)
+	{
+		return s_instance;
+	}
+	// function to check the table entries and return list of any errors
+	QStringList check(void) const;
+	// function to return the signature of the table codes
+	quint32 signature(void) const;
 
 	// CODE RELATED TABLE FUNCTIONS
-	TokenType type(Code code) const;
-	DataType dataType(Code code) const;
+	TokenType type(Code code) const
+	{
+		return s_type[code];
+	}
+	DataType dataType(Code code) const
+	{
+		return s_dataType[code];
+	}
 	Multiple multiple(Code code) const;
 	const QString name(Code code) const;
 	const QString name2(Code code) const;
 	const QString optionName(Code code) const;
 	const QString debugName(Code code) const;
-	int hasFlag(Code code, int flag) const;
-	int precedence(Code code) const;
-	int operandCount(Code code) const;
+	int hasFlag(Code code, int flag) const
+	{
+		return s_flags[code] & flag;
+	}
+	int precedence(Code code) const
+	{
+		return s_precedence[code];
+	}
+	int operandCount(Code code) const
+	{
+		return s_operandCount[code];
+	}
 	DataType operandDataType(Code code, int operand) const;
 	int associatedCodeCount(Code code) const;
 	Code associatedCode(Code code, int index = 0) const;
-	Code *associatedCodeArray(Code code) const;
+	const Code *associatedCodeArray(Code code) const;
 	int secondAssociatedIndex(Code code) const;
 	Code secondAssociatedCode(Code code, int index = 0) const;
 	DataType expectedDataType(Code code) const;
@@ -136,14 +189,26 @@ public:
 	EncodeFunction encodeFunction(Code code) const;
 	OperandTextFunction operandTextFunction(Code code) const;
 	RemoveFunction removeFunction(Code code) const;
+	RecreateFunction recreateFunction(Code code) const;
 
 	// TOKEN RELATED TABLE FUNCTIONS
 	Code unaryCode(Token *token) const;
 	bool isUnaryOperator(Token *token) const;
 	bool isUnaryOrBinaryOperator(Token *token) const;
-	int precedence(Token *token) const;
-	int hasFlag(Token *token, int flag) const;
-	int operandCount(Token *token) const;
+	int precedence(Token *token) const
+	{
+		int prec = token->precedence();
+		return prec != -1 ? prec : precedence(token->code());
+	}
+	int hasFlag(Token *token, int flag) const
+	{
+		// (invalid code tokens have no flags)
+		return token->hasValidCode() ? hasFlag(token->code(), flag) : 0;
+	}
+	int operandCount(Token *token) const
+	{
+		return operandCount(token->code());
+	}
 	DataType expectedDataType(Token *token) const;
 	void setToken(Token *token, Code code);
 	Token *newToken(Code code);
@@ -26,6 +26,7 @@
 #include <QFile>
 #include <QFileInfo>
 #include <QString>
+#include <QTemporaryFile>
 #include <QTextStream>
 
 #include "test_ibcp.h"
@@ -33,6 +34,7 @@
 #include "table.h"
 #include "parser.h"
 #include "programmodel.h"
+#include "registerrunner.h"
 #include "translator.h"
 
 
@@ -45,6 +47,8 @@ Tester::Tester(const QStringList &args)
 	name[OptExpression] = "expression";
 	name[OptTranslator] = "translator";
 	name[OptEncoder] = "encoder";
+	name[OptRecreator] = "recreator";
+	name[OptRunner] = "runner";
 
 	// get base file name of program from first argument
 	m_programName = QFileInfo(args.at(0)).baseName();
@@ -57,7 +61,9 @@ Tester::Tester(const QStringList &args)
 		if (isOption(args.at(1), "-tp", OptParser, name[OptParser])
 			|| isOption(args.at(1), "-te", OptExpression, name[OptExpression])
 			|| isOption(args.at(1), "-tt", OptTranslator, name[OptTranslator])
-			|| isOption(args.at(1), "-tc", OptEncoder, name[OptEncoder]))
+			|| isOption(args.at(1), "-tc", OptEncoder, name[OptEncoder])
+			|| isOption(args.at(1), "-tr", OptRecreator, name[OptRecreator])
+			|| isOption(args.at(1), "-tx", OptRunner, name[OptRunner]))
 		{
 			break;
 		}
@@ -120,7 +126,7 @@ bool Tester::isOption(const QString &arg, const QString &exp,
 QStringList Tester::options(void)
 {
 	return QStringList() << QString("-t <%1>").arg(tr("test_file")) << "-tp"
-		<< "-te" << "-tt" << "-tc";
+		<< "-te" << "-tt" << "-tc" << "-tr" << "-tx";
 }
 
 
@@ -146,11 +152,12 @@ bool Tester::run(QTextStream &cout, CommandLine *commandLine)
 		}
 	}
 
-	// initialize the worker classes
-	if (Table::hasErrors())
+	// check the table entries
+	QStringList tableErrors = Table::instance().check();
+	if (!tableErrors.isEmpty())
 	{
 		int n = 0;
-		foreach (QString error, Table::errorList())
+		foreach (QString error, tableErrors)
 		{
 			qCritical("%s", qPrintable(tr("Error #%1: %2").arg(++n)
 				.arg(error)));
@@ -174,11 +181,13 @@ bool Tester::run(QTextStream &cout, CommandLine *commandLine)
 			cout << line << endl;
 		}
 
-		cout << endl << tr("Table initialization successful.") << endl;
+		cout << endl << tr("Table check successful.") << endl;
 	}
 
 	Translator translator(Table::instance());
 	ProgramModel programUnit;  // creates its own translator instance
+	QStringList programLines;  // lines of program for runner testing
+	QString programInput;      // input lines of program for runner testing
 
 	if (inputMode)
 	{
@@ -203,12 +212,18 @@ bool Tester::run(QTextStream &cout, CommandLine *commandLine)
 				break;
 			}
 			inputLine = input.readLine();
+			if (m_option == OptRunner && inputLine.isEmpty())
+			{
+				// for runner testing, a blank line ends a program
+				runProgram(cout, &programUnit, programLines, programInput);
+				continue;
+			}
 			if (inputLine[0] == '#'
 				|| m_option != OptEncoder && inputLine.isEmpty())
 			{
 				continue;  // skip blank and comment lines
 			}
-			if (m_option != OptEncoder)
+			if (m_option != OptEncoder && m_option != OptRunner)
 			{
 				printInput(cout, inputLine);
 			}
@@ -226,13 +241,35 @@ bool Tester::run(QTextStream &cout, CommandLine *commandLine)
 			translateInput(cout, translator, inputLine, false);
 			break;
 		case OptEncoder:
-			encodeInput(cout, &programUnit, inputLine);
+			if (inputLine[0] == '*')
+			{
+				wideOperandInput(cout, inputLine);
+			}
+			else
+			{
+				encodeInput(cout, &programUnit, inputLine);
+			}
+			break;
+		case OptRecreator:
+			recreateInput(cout, &programUnit, inputLine);
+			break;
+		case OptRunner:
+			if (inputLine[0] == '>')
+			{
+				// line is an input line of the program
+				programInput.append(inputLine.mid(1)).append('\n');
+			}
+			else
+			{
+				programLines.append(inputLine);
+			}
 			break;
 		}
 		// report any token leaks and extra token deletes
-		// FIXME temporary disable for encoder testing since program model
-		//       currently holds on to the rpn lists
-		if (m_option != OptEncoder)
+		// FIXME temporary disable for encoder and recreator testing since
+		//       program model currently holds on to the rpn lists
+		if (m_option != OptEncoder && m_option != OptRecreator
+			&& m_option != OptRunner)
 		{
 			Token::reportErrors();
 		}
@@ -240,21 +277,90 @@ bool Tester::run(QTextStream &cout, CommandLine *commandLine)
 	if (!inputMode)
 	{
 		file.close();
-		if (m_option != OptParser)
+		if (m_option != OptParser && m_option != OptRunner)
 		{
-			cout << endl;  // not for parser testing
+			cout << endl;  // not for parser or runner testing
 		}
 	}
 
+	if (m_option == OptRunner)
+	{
+		runProgram(cout, &programUnit, programLines, programInput);
+	}
+
 	if (m_option == OptEncoder)
 	{
-		// for encoder testing, output program lines
-		cout << "Program:" << endl;
+		// for encoder testing, output program lines from a program image
+		// of the program (to also test saving and loading program images)
+		ProgramModel imageUnit;
+		QTemporaryFile imageFile;
+		bool imageCreated = imageFile.open();
+		imageFile.close();  // only the name of the temporary file is needed
+		// (an image must not be loaded for a different source text)
+		QString source = programUnit.text();
+		if (!imageCreated
+			|| !programUnit.saveImage(imageFile.fileName(), source)
+			|| imageUnit.loadImage(imageFile.fileName(), source + '\n')
+			|| !imageUnit.loadImage(imageFile.fileName(), source))
+		{
+			cout << "Program image failed" << endl;
+			return false;
+		}
+
+		// loading the recreated lines as a whole program must recreate the
+		// same program (to also test loading whole programs)
+		QStringList lines;
 		for (int i = 0; i < programUnit.rowCount(); i++)
 		{
-			cout << i << ": " << programUnit.debugText(i, true) << endl;
+			lines << programUnit.lineText(i);
+		}
+		ProgramModel loadUnit;
+		loadUnit.load(lines);
+		bool loaded = loadUnit.rowCount() == lines.count();
+		for (int i = 0; loaded && i < lines.count(); i++)
+		{
+			ErrorItem errorItem = programUnit.lineError(i);
+			ErrorItem loadErrorItem = loadUnit.lineError(i);
+			loaded = loadUnit.lineText(i) == lines.at(i)
+				&& loadErrorItem.isEmpty() == errorItem.isEmpty()
+				&& (errorItem.isEmpty()
+				|| loadErrorItem.column() == errorItem.column()
+				&& loadErrorItem.message() == errorItem.message());
+		}
+		if (!loaded)
+		{
+			cout << "Program load failed" << endl;
+			return false;
+		}
+
+		// compacting the dictionaries must recreate the same program (to
+		// also test renumbering the operands of the code)
+		programUnit.compact();
+		bool compacted = true;
+		for (int i = 0; compacted && i < lines.count(); i++)
+		{
+			compacted = programUnit.lineText(i) == lines.at(i);
+		}
+		if (!compacted)
+		{
+			cout << "Program compact failed" << endl;
+			return false;
+		}
+
+		cout << "Program:" << endl;
+		for (int i = 0; i < imageUnit.rowCount(); i++)
+		{
+			cout << i << ": " << imageUnit.debugText(i, true) << endl;
 		}
-		cout << programUnit.dictionariesDebugText();
+		cout << imageUnit.dictionariesDebugText();
+
+		// output the number of instructions of the program code and of the
+		// register code lowered from it (for comparing the two codes)
+		RegisterRunner registerRunner(imageUnit.snapshot());
+		int programCount;
+		int registerCount = registerRunner.instructionCount(&programCount);
+		cout << endl << "Instructions: " << programCount << " program code, "
+			<< registerCount << " register code" << endl;
 	}
 
 	return true;
@@ -390,15 +496,15 @@ void Tester::encodeInput(QTextStream &cout, ProgramModel *programUnit,
 			QStringList() << testInput);
 	}
 
-	const ErrorItem *errorItem = programUnit->lineError(lineIndex);
+	ErrorItem errorItem = programUnit->lineError(lineIndex);
 	// only output line if no operation/line number or has an error
-	if (pos == 0 || errorItem != NULL)
+	if (pos == 0 || !errorItem.isEmpty())
 	{
 		printInput(cout, testInput);
-		if (errorItem != NULL)
+		if (!errorItem.isEmpty())
 		{
-			printError(cout, errorItem->column(), errorItem->length(),
-				errorItem->message());
+			printError(cout, errorItem.column(), errorItem.length(),
+				errorItem.message());
 		}
 		else  // get text of encoded line and output it
 		{
@@ -408,6 +514,150 @@ void Tester::encodeInput(QTextStream &cout, ProgramModel *programUnit,
 }
 
 
+// function to encode an input line after enough lines that the variables
+// of the line are entered after the first 65,534 entries of the double
+// variable dictionary (so their operands are wide operands)
+//
+//   - the input line is "*<count> <statement>", where the count is the
+//     number of lines (each with a new variable) put before the statement
+//   - the statement is encoded by loading the program and by inserting it
+//     again, the lines are checked in a program image and when recreated,
+//     then the lines before the statement are removed and the dictionaries
+//     are compacted (the operands are renumbered, but stay wide)
+
+void Tester::wideOperandInput(QTextStream &cout, const QString &testInput)
+{
+	printInput(cout, testInput);
+	int pos = testInput.indexOf(' ');
+	bool ok;
+	int count = testInput.mid(1, pos - 1).toInt(&ok);
+	if (pos == -1 || !ok || count < 0)
+	{
+		cout << QString(" ").repeated(8) << "^-- expected line count" << endl;
+		return;
+	}
+	QString statement = testInput.mid(pos + 1);
+
+	QStringList lines;
+	for (int i = 0; i < count; i++)
+	{
+		lines << QString("V%1=0").arg(i);
+	}
+	lines << statement;
+	ProgramModel programUnit;
+	programUnit.load(lines);
+	ErrorItem errorItem = programUnit.lineError(count);
+	if (!errorItem.isEmpty())
+	{
+		printError(cout, errorItem.column() + pos + 1, errorItem.length(),
+			errorItem.message());
+		return;
+	}
+	programUnit.update(count + 1, 0, 1, QStringList() << statement);
+	QString loadText = programUnit.debugText(count, true);
+	QString insertText = programUnit.debugText(count + 1, true);
+	cout << "Loaded: " << loadText << endl;
+	cout << "Inserted: " << insertText << endl;
+	QString text = programUnit.lineText(count);
+	cout << "Recreated: " << text << endl;
+	if (programUnit.lineText(count + 1) != text)
+	{
+		cout << "Recreate failed" << endl;
+		return;
+	}
+
+	ProgramModel imageUnit;
+	QTemporaryFile imageFile;
+	bool imageCreated = imageFile.open();
+	imageFile.close();  // only the name of the temporary file is needed
+	QString source = programUnit.text();
+	if (!imageCreated || !programUnit.saveImage(imageFile.fileName(), source)
+		|| !imageUnit.loadImage(imageFile.fileName(), source)
+		|| imageUnit.debugText(count, true) != loadText
+		|| imageUnit.debugText(count + 1, true) != insertText)
+	{
+		cout << "Program image failed" << endl;
+		return;
+	}
+
+	programUnit.update(0, count, 0, QStringList());
+	programUnit.compact();
+	cout << "Compacted: " << programUnit.debugText(0, true) << endl;
+	if (programUnit.lineText(0) != text || programUnit.lineText(1) != text
+		|| programUnit.debugText(1) != programUnit.debugText(0))
+	{
+		cout << "Program compact failed" << endl;
+	}
+}
+
+
+// function to append an input line to the program and output the text
+// of the line recreated from the program code
+void Tester::recreateInput(QTextStream &cout, ProgramModel *programUnit,
+	const QString &testInput)
+{
+	int lineIndex = programUnit->rowCount();
+	programUnit->update(lineIndex, 0, 1, QStringList() << testInput);
+
+	ErrorItem errorItem = programUnit->lineError(lineIndex);
+	if (!errorItem.isEmpty())
+	{
+		printError(cout, errorItem.column(), errorItem.length(),
+			errorItem.message());
+	}
+	else  // get recreated text of line and output it
+	{
+		cout << "Output: " << programUnit->lineText(lineIndex) << endl;
+	}
+}
+
+
+// function to load the program lines entered and run the program with the
+// input lines entered (the lines are cleared for the next program)
+void Tester::runProgram(QTextStream &cout, ProgramModel *programUnit,
+	QStringList &programLines, QString &programInput)
+{
+	if (programLines.isEmpty())
+	{
+		return;  // no program
+	}
+	programUnit->load(programLines);
+	ProgramSnapshot program = programUnit->snapshot();
+
+	// run the program code and the register code lowered from it, which must
+	// run the same (same output and same error)
+	QString output[2];
+	QString errorMessage[2];
+	for (int i = 0; i < 2; i++)
+	{
+		Runner *runner = i == 0 ? new Runner(program)
+			: new RegisterRunner(program);
+		QTextStream runOutput(&output[i], QIODevice::WriteOnly);
+		QTextStream runInput(&programInput, QIODevice::ReadOnly);
+		if (!runner->run(runOutput, runInput))
+		{
+			errorMessage[i] = runner->errorMessage();
+		}
+		delete runner;
+	}
+	cout << endl << "Output:" << endl << output[0];
+	if (!errorMessage[0].isEmpty())
+	{
+		cout << endl << errorMessage[0] << endl;
+	}
+	if (output[1] != output[0] || errorMessage[1] != errorMessage[0])
+	{
+		cout << "Register code run differs:" << endl << output[1];
+		if (!errorMessage[1].isEmpty())
+		{
+			cout << endl << errorMessage[1] << endl;
+		}
+	}
+	programLines.clear();
+	programInput.clear();
+}
+
+
 // function to print the contents of a token
 bool Tester::printToken(QTextStream &cout, Token *token, bool tab)
 {
@@ -46,6 +46,8 @@ class Tester
 		OptExpression,
 		OptTranslator,
 		OptEncoder,
+		OptRecreator,
+		OptRunner,
 		OptSizeOf,
 		OptError = OptSizeOf
 	};
@@ -57,6 +59,11 @@ class Tester
 		const QString &testInput, bool exprMode);
 	void encodeInput(QTextStream &cout, ProgramModel *programModel,
 		QString &testInput);
+	void wideOperandInput(QTextStream &cout, const QString &testInput);
+	void recreateInput(QTextStream &cout, ProgramModel *programModel,
+		const QString &testInput);
+	void runProgram(QTextStream &cout, ProgramModel *programModel,
+		QStringList &programLines, QString &programInput);
 	void printInput(QTextStream &cout, const QString &inputLine)
 	{
 		// no 'tr()' for this string - must match expected results file
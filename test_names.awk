@@ -60,7 +60,7 @@ BEGIN {
 	{
 		if (code_enum == 0)
 		{
-			if (line ~ /static TableEntry tableEntries/)
+			if (line ~ /static const TableEntry tableEntries/)
 			{
 				# found start of table entries
 				code_enum = 1
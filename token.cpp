@@ -492,6 +492,10 @@ bool Token::operator==(const Token &other) const
 			{
 				return false;
 			}
+			if (m_code == CatStrs_Code && m_valueInt != other.m_valueInt)
+			{
+				return false;  // different number of strings
+			}
 		}
 		break;
 
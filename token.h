@@ -271,6 +271,11 @@ public:
 	{
 		return m_code == Null_Code;
 	}
+	int memory(void) const
+	{
+		// memory of token (in bytes, estimated)
+		return sizeof(Token) - sizeof(QString) + stringMemory(m_string);
+	}
 
 	// set length to include second token
 	Token *setThrough(Token *token2)
@@ -316,6 +321,12 @@ private:
 public:
 	// static member functions
 	static void initialize(void);
+	static int freeMemory(void)
+	{
+		// memory of the tokens on the free stack and the stack
+		return s_freeStack.count() * sizeof(Token)
+			+ s_freeStack.capacity() * sizeof(Token *);
+	}
 	static const QString message(TokenStatus status)
 	{
 		return s_messageArray[status];
@@ -28,15 +28,6 @@
 #include "parser.h"
 
 
-// highest precedence value
-enum {
-	HighestPrecedence = 127
-	// this value was selected as the highest value because it is the highest
-	// one-byte signed value (in case the precedence member is changed to a
-	// char); all precedences in the table must be below this value
-};
-
-
 Translator::Translator(Table &table): m_table(table),
 	m_parser(new Parser(table)), m_output(NULL), m_pendingParen(NULL)
 {
@@ -121,10 +112,14 @@ RpnList *Translator::translate(const QString &input, TestMode testMode)
 				status = BUG_DoneStackNotEmpty;
 			}
 
-			if (testMode == No_TestMode
-				&& !m_output->setCodeSize(m_table, token))
+			if (testMode == No_TestMode)
 			{
-				status = BUG_NotYetImplemented;
+				m_output->combineConcatenations(m_table);
+				m_output->combinePrintConstants();
+				if (!m_output->setCodeSize(m_table, token))
+				{
+					status = BUG_NotYetImplemented;
+				}
 			}
 		}
 		else
@@ -718,7 +713,7 @@ TokenStatus Translator::processInternalFunction(Token *&token)
 				}
 				if (doneToken->isType(Constant_TokenType))
 				{
-					doneToken->setCode(Const_Code);
+					m_table.setTokenCode(doneToken, Const_Code);
 				}
 			}
 		}
@@ -1165,10 +1160,13 @@ void Translator::checkPendingParen(Token *token, bool popped)
 	{
 		// may need to add a dummy token if the precedence of the last
 		// operator added within the last parentheses sub-expression
-		// is higher than or same as (popped tokens only) the operator
+		// is higher than or same as (popped tokens only) the operator,
+		// or same as a unary operator (the recreator does not add
+		// parentheses around a unary operand of the same precedence)
 		int precedence = m_table.precedence(token);
 		if (m_lastPrecedence > precedence
-			|| !popped && m_lastPrecedence == precedence)
+			|| m_lastPrecedence == precedence
+			&& (!popped || m_table.operandCount(token) == 1))
 		{
 			Token *lastToken = m_doneStack.top().rpnItem->token();
 			if (!lastToken->hasSubCode(Paren_SubCode))